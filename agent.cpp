@@ -0,0 +1,135 @@
+#include "collector.h"
+
+// Headless collector: runs every collector on its configured schedule and
+// keeps the on-disk history, without SDL, OpenGL or ImGui
+
+static void PrintSummary(const MonitorSnapshot& snapshot) {
+    const SystemInfo& info = snapshot.system_info;
+    printf("host %s  cpu %.1f%%  temp %.1f C  fan %d rpm\n", info.hostname.c_str(), info.cpu_usage,
+           info.temperature, info.fan_speed);
+    printf("memory %.1f%%  swap %.1f%%  disk %.1f%%\n", info.memory_usage, info.swap_usage, info.disk_usage);
+    printf("processes %d (running %d, sleeping %d, zombie %d, stopped %d)\n", info.total_processes,
+           info.running_processes, info.sleeping_processes, info.zombie_processes, info.stopped_processes);
+    for (const auto& iface : snapshot.network_interfaces) {
+        printf("  %-12s rx %llu B/s  tx %llu B/s\n", iface.name.c_str(), (unsigned long long)iface.rx_rate,
+               (unsigned long long)iface.tx_rate);
+    }
+}
+
+static void PrintUsage(const char* program) {
+    printf("Usage: %s [--once] [--root DIR] [--metrics [ADDRESS:]PORT] [--export PATH [--export-format csv|jsonl]\n"
+           "          [--export-groups system,cores,processes,interfaces]]\n"
+           "  --once      sample every collector twice one second apart, print a summary and exit\n"
+           "  --root      collect from DIR/proc and DIR/sys instead of the host's, e.g. a tree\n"
+           "              written by sysmon-gen-proctree\n"
+           "  --metrics   serve OpenMetrics on http://ADDRESS:PORT/metrics (default 127.0.0.1:%d),\n"
+           "              overriding metrics.port and metrics.address in the config file\n"
+           "  --export    write a record per tick to PATH (a file, a named pipe or - for stdout),\n"
+           "              overriding the export.* settings in the config file\n"
+           "Without options the agent runs until SIGINT or SIGTERM.\n"
+           "History is kept in history.dir. Only one process appends to a day's segment at a time;\n"
+           "while the GUI holds it, the agent keeps history in memory only.\n", program, MetricsServer::DEFAULT_PORT);
+}
+
+int main(int argc, char** argv) {
+    bool once = false;
+    std::string export_path, export_format, export_groups;
+    std::string metrics_address = "127.0.0.1";
+    int metrics_port = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (strcmp(argv[i], "--metrics") == 0) {
+            metrics_port = MetricsServer::DEFAULT_PORT;
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+                std::string endpoint = argv[++i];
+                size_t colon = endpoint.rfind(':');
+                if (colon != std::string::npos) {
+                    metrics_address = endpoint.substr(0, colon);
+                    endpoint = endpoint.substr(colon + 1);
+                }
+                metrics_port = atoi(endpoint.c_str());
+            }
+        } else if (strcmp(argv[i], "--root") == 0 && i + 1 < argc) {
+            std::string root = argv[++i];
+            SetSystemRoots(root + "/proc", root + "/sys");
+        } else if (strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+            export_path = argv[++i];
+        } else if (strcmp(argv[i], "--export-format") == 0 && i + 1 < argc) {
+            export_format = argv[++i];
+        } else if (strcmp(argv[i], "--export-groups") == 0 && i + 1 < argc) {
+            export_groups = argv[++i];
+        } else {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+#ifndef _WIN32
+    // Block the stop signals before any thread starts so only sigwait() sees them
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+#endif
+
+    Collector collector;
+
+    if (once) {
+        // Rates need two samples
+        collector.Update();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        collector.Update();
+        const MonitorSnapshot* snapshot = collector.AcquireSnapshot();
+        if (snapshot) PrintSummary(*snapshot);
+        collector.ReleaseSnapshot(snapshot);
+        return 0;
+    }
+
+    MetricsServer metrics_server(collector);
+    bool serving = metrics_port > 0
+        ? metrics_server.Start(metrics_address, metrics_port,
+                               collector.GetConfig().GetInt("metrics.top_processes", MetricsServer::DEFAULT_TOP_PROCESSES))
+        : metrics_server.StartFromConfig(collector.GetConfig());
+    if (metrics_port > 0 && !serving) return 1;
+
+    ExportOptions export_options = ExportOptions::FromConfig(collector.GetConfig());
+    if (!export_path.empty()) export_options.path = export_path;
+    if (!export_format.empty()) {
+        if (export_format != "csv" && export_format != "jsonl") {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        export_options.csv = export_format == "csv";
+    }
+    if (!export_groups.empty() && !export_options.ParseGroups(export_groups)) {
+        fprintf(stderr, "sysmon-agent: unknown export group in \"%s\"\n", export_groups.c_str());
+        return 1;
+    }
+    SnapshotExporter exporter(collector);
+    exporter.Start(export_options);
+
+    std::atomic<bool> running{true};
+    std::thread collector_thread([&] {
+        while (running) {
+            auto next_deadline = collector.RunScheduled();
+            collector.WaitUntil(next_deadline);
+        }
+    });
+
+#ifdef _WIN32
+    // Stopped with Ctrl+C, which ends the process
+    collector_thread.join();
+#else
+    int signal_number = 0;
+    sigwait(&stop_signals, &signal_number);
+    fprintf(stderr, "sysmon-agent: stopping on signal %d\n", signal_number);
+    metrics_server.Stop();
+    exporter.Stop();
+    running = false;
+    collector.Wake();
+    collector_thread.join();
+#endif
+    return 0;
+}
@@ -0,0 +1,562 @@
+#include "header.h"
+
+// Collector benchmarks (Linux only)
+#ifndef _WIN32
+#include <sys/stat.h>
+
+SystemMonitor g_monitor;
+bool g_running = true;
+
+using BenchClock = std::chrono::steady_clock;
+
+static double ElapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Write a synthetic /proc-like tree with `count` pid directories holding a stat file
+static bool WriteSyntheticProcTree(const std::string& root, int count) {
+    if (mkdir(root.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+    static const char* names[] = {"bash", "kworker/u16:2-events_unbound", "Web Content", "weird) (name", "cc1plus"};
+    char path[256];
+    char line[512];
+    for (int pid = 1; pid <= count; ++pid) {
+        snprintf(path, sizeof(path), "%s/%d", root.c_str(), pid);
+        mkdir(path, 0755);
+        snprintf(path, sizeof(path), "%s/%d/stat", root.c_str(), pid);
+
+        int len = snprintf(line, sizeof(line),
+            "%d (%s) S 1 %d %d 0 -1 4194560 2524 32308 69 223 %d %d 4799 517 20 0 6 0 %d 24317952 %d "
+            "18446744073709551615 1 1 0 0 0 0 0 4096 1088 0 0 0 17 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+            pid, names[pid % 5], pid, pid, pid % 977, pid % 311, 1000 + pid, 100 + pid % 5000);
+
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        ssize_t written = write(fd, line, len);
+        close(fd);
+        if (written != len) return false;
+    }
+    return true;
+}
+
+static void RemoveSyntheticProcTree(const std::string& root, int count) {
+    char path[256];
+    for (int pid = 1; pid <= count; ++pid) {
+        snprintf(path, sizeof(path), "%s/%d/stat", root.c_str(), pid);
+        unlink(path);
+        snprintf(path, sizeof(path), "%s/%d", root.c_str(), pid);
+        rmdir(path);
+    }
+    rmdir(root.c_str());
+}
+
+// The std::string/ifstream/istringstream scan that UpdateProcesses used to do
+static size_t ScanLegacy(const std::string& root) {
+    DIR* proc_dir = opendir(root.c_str());
+    if (!proc_dir) return 0;
+
+    size_t parsed = 0;
+    struct dirent* entry;
+    while ((entry = readdir(proc_dir)) != nullptr) {
+        if (!isdigit(entry->d_name[0])) continue;
+
+        int pid = std::stoi(entry->d_name);
+        std::string stat_path = root + "/" + std::string(entry->d_name) + "/stat";
+        std::string status_path = root + "/" + std::string(entry->d_name) + "/status";
+
+        std::ifstream stat_file(stat_path);
+        if (!stat_file.is_open()) continue;
+
+        std::string line;
+        std::getline(stat_file, line);
+
+        std::istringstream iss(line);
+        std::string pid_str, comm, state;
+        long long utime, stime, cutime, cstime, starttime;
+        long vsize, rss;
+
+        iss >> pid_str >> comm >> state;
+        for (int i = 0; i < 10; ++i) iss >> pid_str;
+        iss >> utime >> stime >> cutime >> cstime;
+        for (int i = 0; i < 4; ++i) iss >> pid_str;
+        iss >> starttime;
+        iss >> vsize >> rss;
+
+        ProcessInfo proc;
+        proc.pid = pid;
+        proc.name = comm.substr(1, comm.length() - 2);
+        proc.state = state;
+        parsed++;
+    }
+
+    closedir(proc_dir);
+    return parsed;
+}
+
+static size_t ScanFast(const std::string& root) {
+    DIR* proc_dir = opendir(root.c_str());
+    if (!proc_dir) return 0;
+
+    int proc_fd = dirfd(proc_dir);
+    size_t parsed = 0;
+    struct dirent* entry;
+    while ((entry = readdir(proc_dir)) != nullptr) {
+        if (!isdigit(entry->d_name[0])) continue;
+
+        ProcStat stat;
+        if (ReadProcStat(proc_fd, entry->d_name, stat)) parsed++;
+    }
+
+    closedir(proc_dir);
+    return parsed;
+}
+
+template <typename Fn>
+static double BestOf(int runs, Fn fn) {
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        auto start = BenchClock::now();
+        fn();
+        best = std::min(best, ElapsedMs(start));
+    }
+    return best;
+}
+
+static void BenchProcStat(const std::string& root, int pid_count) {
+    // Parse only: the same stat line fed through both parsers
+    const char* line = "12345 (weird) (name) S 1 12345 12345 0 -1 4194560 2524 32308 69 223 53 96 4799 517 "
+                       "20 0 6 0 6123 24317952 2350 18446744073709551615 1 1 0 0 0 0 0 4096 1088 0 0 0 "
+                       "17 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n";
+    size_t line_len = strlen(line);
+
+    double legacy_parse = BestOf(5, [&] {
+        for (int i = 0; i < pid_count; ++i) {
+            std::istringstream iss(line);
+            std::string pid_str, comm, state;
+            long long utime, stime;
+            iss >> pid_str >> comm >> state;
+            for (int f = 0; f < 10; ++f) iss >> pid_str;
+            iss >> utime >> stime;
+        }
+    });
+    double fast_parse = BestOf(5, [&] {
+        ProcStat stat;
+        for (int i = 0; i < pid_count; ++i) ParseProcStat(line, line_len, stat);
+    });
+
+    // Full scan: readdir + open + read + parse over the synthetic tree
+    size_t legacy_count = 0, fast_count = 0;
+    double legacy_scan = BestOf(5, [&] { legacy_count = ScanLegacy(root); });
+    double fast_scan = BestOf(5, [&] { fast_count = ScanFast(root); });
+
+    // The live /proc for reference
+    size_t live_count = 0;
+    double live_legacy = BestOf(5, [&] { live_count = ScanLegacy("/proc"); });
+    double live_fast = BestOf(5, [&] { ScanFast("/proc"); });
+
+    printf("proc_stat parse  %6d lines  legacy %8.2f ms  fast %8.2f ms  (%.1fx)\n",
+           pid_count, legacy_parse, fast_parse, legacy_parse / fast_parse);
+    printf("proc_stat scan   %6zu pids   legacy %8.2f ms  fast %8.2f ms  (%.1fx)\n",
+           fast_count, legacy_scan, fast_scan, legacy_scan / fast_scan);
+    printf("proc_stat /proc  %6zu pids   legacy %8.2f ms  fast %8.2f ms  (%.1fx)\n",
+           live_count, live_legacy, live_fast, live_legacy / live_fast);
+    if (legacy_count != fast_count) {
+        printf("warning: legacy scan saw %zu pids, fast scan saw %zu\n", legacy_count, fast_count);
+    }
+}
+
+// One process tick (list, sharded parse, merge into the table) per worker count
+static void BenchScanScaling(const std::string& root) {
+    int proc_fd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (proc_fd < 0) return;
+
+    std::vector<int> pids;
+    std::vector<std::vector<ProcStat>> results;
+    ProcessTable table;
+
+    printf("process tick scaling (%u hardware threads)\n", std::thread::hardware_concurrency());
+    for (int workers : {1, 2, 4, 8, 16}) {
+        WorkerPool pool;
+        pool.Resize(workers - 1);
+
+        size_t rows = 0;
+        double tick = BestOf(5, [&] {
+            ListProcPids(proc_fd, pids);
+            ScanProcStats(proc_fd, pids, pool, workers, results);
+            table.BeginUpdate();
+            for (const auto& shard : results) {
+                for (const ProcStat& stat : shard) {
+                    ProcessInfo& proc = table.Upsert(stat.pid, stat.starttime);
+                    if (proc.name != stat.comm) proc.name = stat.comm;
+                    proc.state.assign(1, stat.state);
+                }
+            }
+            table.EndUpdate();
+            rows = table.LiveCount();
+        });
+        printf("  workers %2d  %6zu pids  %8.2f ms\n", workers, rows, tick);
+    }
+
+    close(proc_fd);
+}
+
+// Encoded size and decode speed of the series codec on traces recorded from
+// the live collectors: floats raw are 12 bytes a point, counters 16
+static void BenchSeriesCodec() {
+    const int ticks = 150;
+    const auto interval = std::chrono::milliseconds(20);
+
+    struct FloatTrace { std::vector<int64_t> times; std::vector<float> values; };
+    struct CounterTrace { std::vector<int64_t> times; std::vector<uint64_t> values; };
+    std::vector<FloatTrace> cpu(1), temp(1), cores;
+    std::vector<CounterTrace> interfaces, processes;
+
+    SystemManager& system = g_monitor.GetCollector().GetSystemManager();
+    NetworkManager& network = g_monitor.GetCollector().GetNetworkManager();
+    int proc_fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    std::vector<int> pids;
+    ListProcPids(proc_fd, pids);
+    processes.resize(pids.size());
+    
+    for (int tick = 0; tick < ticks; ++tick) {
+        auto start = BenchClock::now();
+        system.UpdateCPU();
+        system.UpdateThermal();
+        network.Update();
+        int64_t now = (int64_t)(WallSeconds() * 1000.0);
+
+        auto add_float = [&](FloatTrace& trace, float value) {
+            trace.times.push_back(now);
+            trace.values.push_back(value);
+        };
+        auto add_counter = [&](CounterTrace& trace, uint64_t value) {
+            trace.times.push_back(now);
+            trace.values.push_back(value);
+        };
+
+        add_float(cpu[0], system.GetSystemInfo().cpu_usage);
+        add_float(temp[0], system.GetSystemInfo().temperature);
+        const CPUTimes& times = system.GetCPUTimes();
+        cores.resize(std::max(cores.size(), (size_t)times.CoreCount()));
+        for (int core = 0; core < times.CoreCount(); ++core) {
+            add_float(cores[core], times.busy[core + 1]);
+        }
+        const auto& ifaces = network.GetNetworkInterfaces();
+        interfaces.resize(std::max(interfaces.size(), ifaces.size() * 2));
+        for (size_t i = 0; i < ifaces.size(); ++i) {
+            add_counter(interfaces[i * 2], ifaces[i].rx_bytes);
+            add_counter(interfaces[i * 2 + 1], ifaces[i].tx_bytes);
+        }
+        for (size_t i = 0; i < pids.size(); ++i) {
+            // Exited processes keep their last value
+            ProcStat stat;
+            uint64_t value = processes[i].values.empty() ? 0 : processes[i].values.back();
+            if (ReadProcStat(proc_fd, pids[i], stat)) value = stat.utime + stat.stime;
+            add_counter(processes[i], value);
+        }
+
+        std::this_thread::sleep_until(start + interval);
+    }
+    if (proc_fd >= 0) close(proc_fd);
+
+    printf("series codec on %d ticks recorded at %lld ms\n", ticks, (long long)interval.count());
+    std::vector<uint8_t> block;
+    auto report_floats = [&](const char* label, const std::vector<FloatTrace>& traces) {
+        size_t raw = 0, encoded = 0;
+        for (const auto& trace : traces) {
+            block.clear();
+            EncodeFloatBlock(trace.times.data(), trace.values.data(), trace.values.size(), block);
+            raw += trace.values.size() * 12;
+            encoded += block.size();
+        }
+        printf("  %-18s %4zu series  raw %8zu B  encoded %7zu B  (%.1fx)\n", label, traces.size(), raw, encoded,
+               encoded ? (double)raw / encoded : 0.0);
+    };
+    auto report_counters = [&](const char* label, const std::vector<CounterTrace>& traces) {
+        size_t raw = 0, encoded = 0;
+        for (const auto& trace : traces) {
+            block.clear();
+            EncodeCounterBlock(trace.times.data(), trace.values.data(), trace.values.size(), block);
+            raw += trace.values.size() * 16;
+            encoded += block.size();
+        }
+        printf("  %-18s %4zu series  raw %8zu B  encoded %7zu B  (%.1fx)\n", label, traces.size(), raw, encoded,
+               encoded ? (double)raw / encoded : 0.0);
+    };
+    report_floats("cpu usage", cpu);
+    report_floats("per-core busy", cores);
+    report_floats("temperature", temp);
+    report_counters("interface bytes", interfaces);
+    report_counters("process cpu ticks", processes);
+
+    // Decode throughput over the per-core blocks and the process blocks
+    std::vector<std::vector<uint8_t>> float_blocks, counter_blocks;
+    size_t float_points = 0, counter_points = 0;
+    for (const auto& trace : cores) {
+        float_blocks.emplace_back();
+        EncodeFloatBlock(trace.times.data(), trace.values.data(), trace.values.size(), float_blocks.back());
+        float_points += trace.values.size();
+    }
+    for (const auto& trace : processes) {
+        counter_blocks.emplace_back();
+        EncodeCounterBlock(trace.times.data(), trace.values.data(), trace.values.size(), counter_blocks.back());
+        counter_points += trace.values.size();
+    }
+    std::vector<int64_t> out_times(ticks);
+    std::vector<float> out_floats(ticks);
+    std::vector<uint64_t> out_counters(ticks);
+    const int repeat = 200;
+    double float_ms = BestOf(5, [&] {
+        for (int r = 0; r < repeat; ++r) {
+            for (size_t i = 0; i < float_blocks.size(); ++i) {
+                DecodeFloatBlock(float_blocks[i].data(), float_blocks[i].size(), cores[i].values.size(),
+                                 out_times.data(), out_floats.data());
+            }
+        }
+    });
+    double counter_ms = BestOf(5, [&] {
+        for (int r = 0; r < repeat; ++r) {
+            for (size_t i = 0; i < counter_blocks.size(); ++i) {
+                DecodeCounterBlock(counter_blocks[i].data(), counter_blocks[i].size(), processes[i].values.size(),
+                                   out_times.data(), out_counters.data());
+            }
+        }
+    });
+    printf("  decode floats   %8.1f Mpoints/s\n", float_points * repeat / float_ms / 1000.0);
+    printf("  decode counters %8.1f Mpoints/s\n", counter_points * repeat / counter_ms / 1000.0);
+}
+
+static void FillSyntheticSnapshot(MonitorSnapshot& snapshot, int pid_count) {
+    snapshot.time = 1700000000.0;
+    snapshot.system_info.cpu_usage = 12.5f;
+    snapshot.system_info.total_memory = 16ull << 30;
+    snapshot.system_info.used_memory = 5ull << 30;
+    snapshot.cpu_times.Resize(9);
+    snapshot.cpu_times.has_previous = true;
+    snapshot.processes.resize(pid_count);
+    for (int i = 0; i < pid_count; ++i) {
+        ProcessInfo& proc = snapshot.processes[i];
+        proc.pid = 100 + i;
+        proc.name = "worker-" + std::to_string(i % 500);
+        proc.state = "S";
+        proc.cpu_usage = (float)((i * 7919) % 10007) / 100.0f;
+        proc.memory_usage = (float)((i * 104729) % 1009) / 100.0f;
+        proc.alive = true;
+    }
+    for (int i = 0; i < 4; ++i) {
+        NetworkInterface iface;
+        iface.name = "eth" + std::to_string(i);
+        iface.rx_bytes = 123456789ull * (i + 1);
+        iface.tx_bytes = 98765432ull * (i + 1);
+        snapshot.network_interfaces.push_back(iface);
+    }
+    FormatSystemText(snapshot);
+    FormatProcessText(snapshot);
+    FormatNetworkText(snapshot);
+}
+
+// One /metrics scrape over a synthetic snapshot, rendered into a reused buffer
+static void BenchMetrics(int pid_count) {
+    MonitorSnapshot snapshot;
+    FillSyntheticSnapshot(snapshot, pid_count);
+
+    MetricsServer server(g_monitor.GetCollector());
+    std::vector<char> body;
+    double best = BestOf(50, [&] {
+        body.clear();
+        server.RenderMetrics(snapshot, body);
+    });
+    printf("metrics scrape   %6d pids   %8.3f ms  %zu B\n", pid_count, best, body.size());
+}
+
+// Formatting one tick of every export group
+static void BenchExport(int pid_count) {
+    MonitorSnapshot snapshot;
+    FillSyntheticSnapshot(snapshot, pid_count);
+    bool changed[COLLECTOR_COUNT];
+    std::fill(changed, changed + COLLECTOR_COUNT, true);
+
+    ExportOptions options;
+    options.groups = ExportOptions::GROUP_SYSTEM | ExportOptions::GROUP_CORES | ExportOptions::GROUP_PROCESSES |
+                     ExportOptions::GROUP_INTERFACES;
+    std::vector<char> out;
+    for (bool csv : {false, true}) {
+        options.csv = csv;
+        double best = BestOf(20, [&] {
+            out.clear();
+            SnapshotExporter::FormatSnapshot(options, snapshot, changed, out);
+        });
+        printf("export %-5s     %6d pids   %8.3f ms  %zu B  (%.0f MB/s)\n", csv ? "csv" : "jsonl", pid_count, best,
+               out.size(), out.size() / best / 1000.0);
+    }
+}
+
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t i = std::min(samples.size() - 1, (size_t)(p / 100.0 * samples.size()));
+    return samples[i];
+}
+
+// Headless ImGui frames of the whole monitor while the collector runs a
+// 200 ms pass back to back: once holding one mutex across the pass and the
+// frame (the old data_mutex scheme), once publishing snapshots
+static void CreateHeadlessContext() {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 800);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+static void BenchFrameTimes() {
+    const auto slow_pass = std::chrono::milliseconds(200);
+    const auto duration = std::chrono::seconds(2);
+    
+    CreateHeadlessContext();
+    
+    std::mutex legacy_mutex;
+    auto run = [&](const char* label, bool collect, bool legacy_lock) {
+        std::atomic<bool> collecting{collect};
+        std::thread collector([&] {
+            while (collecting) {
+                if (legacy_lock) {
+                    std::lock_guard<std::mutex> lock(legacy_mutex);
+                    g_monitor.GetCollector().Update();
+                    std::this_thread::sleep_for(slow_pass);
+                } else {
+                    g_monitor.GetCollector().Update();
+                    std::this_thread::sleep_for(slow_pass);
+                }
+            }
+        });
+        
+        std::vector<double> frames;
+        auto end = BenchClock::now() + duration;
+        while (BenchClock::now() < end) {
+            auto start = BenchClock::now();
+            ImGui::NewFrame();
+            ImGui::Begin("Monitor");
+            if (legacy_lock) {
+                std::lock_guard<std::mutex> lock(legacy_mutex);
+                g_monitor.RenderSystemMonitor();
+            } else {
+                g_monitor.RenderSystemMonitor();
+            }
+            ImGui::End();
+            ImGui::Render();
+            frames.push_back(ElapsedMs(start));
+            
+            // Pace like a 60 Hz vsync
+            std::this_thread::sleep_until(start + std::chrono::microseconds(16667));
+        }
+        
+        collecting = false;
+        collector.join();
+        printf("  %-28s %5zu frames  p50 %7.3f ms  p99 %7.3f ms  max %7.3f ms\n", label, frames.size(),
+               Percentile(frames, 50), Percentile(frames, 99), Percentile(frames, 100));
+    };
+    
+    printf("frame time with a %lld ms collection pass\n", (long long)slow_pass.count());
+    run("idle collector", false, false);
+    run("shared mutex (old scheme)", true, true);
+    run("snapshots", true, false);
+    
+    ImGui::DestroyContext();
+}
+
+// The process table as it was drawn before clipping: every row that passes
+// the filter submitted, each pid formatted
+static void RenderEveryRow(MemoryView& memory_view, const MonitorSnapshot& snapshot, const std::string& filter) {
+    if (!ImGui::BeginTable("ProcessTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+        return;
+    }
+    memory_view.RefreshDisplayOrder(snapshot);
+    for (uint32_t row : memory_view.FilterDisplayOrder(snapshot, filter)) {
+        const ProcessInfo& proc = snapshot.processes[row];
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        ImGui::Selectable(std::to_string(proc.pid).c_str(), false, ImGuiSelectableFlags_SpanAllColumns);
+        ImGui::TableSetColumnIndex(1);
+        ImGui::Text("%s", proc.name.c_str());
+        ImGui::TableSetColumnIndex(2);
+        ImGui::Text("%s", proc.state.c_str());
+        ImGui::TableSetColumnIndex(3);
+        ImGui::Text("%.1f", proc.cpu_usage);
+        ImGui::TableSetColumnIndex(4);
+        ImGui::Text("%.2f", proc.memory_usage);
+    }
+    ImGui::EndTable();
+}
+
+// Headless frames of the Memory & Processes tab as the process count grows;
+// with the clipper the frame time should not depend on it
+static void BenchProcessTable() {
+    const int frame_count = 60;
+    CreateHeadlessContext();
+    
+    printf("process table frame time\n");
+    for (int pid_count : {1000, 10000, 100000}) {
+        MonitorSnapshot snapshot;
+        FillSyntheticSnapshot(snapshot, pid_count);
+        snapshot.membership_version = 1;
+        // A fresh view per size: a reused one sees the same membership_version and keeps the old display order
+        MemoryView memory_view(g_monitor.GetCollector().GetMemoryManager());
+        
+        for (bool clipped : {false, true}) {
+            std::vector<double> frames;
+            for (int f = 0; f < frame_count; ++f) {
+                auto start = BenchClock::now();
+                ImGui::NewFrame();
+                ImGui::SetNextWindowPos(ImVec2(0, 0));
+                ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+                ImGui::Begin("Monitor");
+                if (clipped) memory_view.RenderMemoryAndProcesses(snapshot);
+                else RenderEveryRow(memory_view, snapshot, "");
+                ImGui::End();
+                ImGui::Render();
+                frames.push_back(ElapsedMs(start));
+            }
+            printf("  %-12s %6d pids   p50 %8.3f ms  p99 %8.3f ms\n", clipped ? "clipped" : "every row", pid_count,
+                   Percentile(frames, 50), Percentile(frames, 99));
+        }
+    }
+    
+    ImGui::DestroyContext();
+}
+
+int main(int argc, char** argv) {
+    int pid_count = argc > 1 ? atoi(argv[1]) : 40000;
+
+    char root_buf[] = "/tmp/sysmon-bench-XXXXXX";
+    if (!mkdtemp(root_buf)) return 1;
+    std::string root = std::string(root_buf) + "/proc";
+    if (!WriteSyntheticProcTree(root, pid_count)) {
+        printf("failed to write synthetic tree under %s\n", root.c_str());
+        return 1;
+    }
+
+    BenchProcStat(root, pid_count);
+    BenchScanScaling(root);
+    BenchSeriesCodec();
+    BenchMetrics(pid_count);
+    BenchExport(pid_count);
+    BenchFrameTimes();
+    BenchProcessTable();
+
+    RemoveSyntheticProcTree(root, pid_count);
+    rmdir(root_buf);
+    return 0;
+}
+#else
+SystemMonitor g_monitor;
+bool g_running = true;
+
+int main() {
+    printf("Benchmarks are only available on Linux\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,236 @@
+#include "collector.h"
+
+// Bits are written most significant first
+class BitWriter {
+private:
+    std::vector<uint8_t>& out;
+    uint64_t pending = 0;
+    int pending_bits = 0;
+
+public:
+    explicit BitWriter(std::vector<uint8_t>& target) : out(target) {}
+
+    void Write(uint64_t value, int bits) {
+        if (bits > 32) {
+            Write(value >> 32, bits - 32);
+            bits = 32;
+        }
+        pending = (pending << bits) | (value & ((1ull << bits) - 1));
+        pending_bits += bits;
+        while (pending_bits >= 8) {
+            pending_bits -= 8;
+            out.push_back((uint8_t)(pending >> pending_bits));
+        }
+        pending &= (1ull << pending_bits) - 1;
+    }
+
+    // Pads the last byte with zeros
+    void Flush() {
+        if (pending_bits > 0) out.push_back((uint8_t)(pending << (8 - pending_bits)));
+        pending = 0;
+        pending_bits = 0;
+    }
+};
+
+class BitReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;            // In bits
+
+public:
+    BitReader(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+    // Up to 32 bits; reading past the end yields zeros and sets Overrun()
+    uint32_t Read(int bits) {
+        size_t byte = position >> 3;
+        uint64_t window = 0;
+        if (byte + 8 <= size) {
+            memcpy(&window, data + byte, 8);
+            window = __builtin_bswap64(window);
+        } else {
+            for (size_t i = 0; i < 8; ++i) {
+                window = (window << 8) | (byte + i < size ? data[byte + i] : 0);
+            }
+        }
+        uint32_t value = (uint32_t)((window << (position & 7)) >> (64 - bits));
+        position += bits;
+        return value;
+    }
+
+    uint64_t Read64() {
+        uint64_t high = Read(32);
+        return (high << 32) | Read(32);
+    }
+
+    bool Overrun() const { return position > size * 8; }
+    size_t BytesUsed() const { return (position + 7) >> 3; }
+};
+
+static uint64_t ZigZag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t UnZigZag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// Delta-of-delta buckets: '0' repeats the last delta, then 7, 9 and 12 bit
+// zigzag values, and a 64-bit escape for clock jumps
+static void WriteTimestamp(BitWriter& writer, size_t i, const int64_t* times, int64_t& last_delta) {
+    if (i == 0) {
+        writer.Write((uint64_t)times[0], 64);
+        return;
+    }
+    int64_t delta = times[i] - times[i - 1];
+    uint64_t dod = ZigZag(delta - last_delta);
+    last_delta = delta;
+    if (dod == 0) {
+        writer.Write(0, 1);
+    } else if (dod < (1u << 7)) {
+        writer.Write(0x2, 2);
+        writer.Write(dod, 7);
+    } else if (dod < (1u << 9)) {
+        writer.Write(0x6, 3);
+        writer.Write(dod, 9);
+    } else if (dod < (1u << 12)) {
+        writer.Write(0xE, 4);
+        writer.Write(dod, 12);
+    } else {
+        writer.Write(0xF, 4);
+        writer.Write(dod, 64);
+    }
+}
+
+static int64_t ReadTimestamp(BitReader& reader, size_t i, int64_t previous, int64_t& last_delta) {
+    if (i == 0) return (int64_t)reader.Read64();
+
+    uint64_t dod;
+    if (reader.Read(1) == 0) dod = 0;
+    else if (reader.Read(1) == 0) dod = reader.Read(7);
+    else if (reader.Read(1) == 0) dod = reader.Read(9);
+    else if (reader.Read(1) == 0) dod = reader.Read(12);
+    else dod = reader.Read64();
+    last_delta += UnZigZag(dod);
+    return previous + last_delta;
+}
+
+void EncodeFloatBlock(const int64_t* times, const float* values, size_t count, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    int64_t last_delta = 0;
+    uint32_t previous = 0;
+    int leading = -1, trailing = 0;     // Window of the last '11' value
+
+    for (size_t i = 0; i < count; ++i) {
+        WriteTimestamp(writer, i, times, last_delta);
+
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        if (i == 0) {
+            writer.Write(bits, 32);
+            previous = bits;
+            continue;
+        }
+
+        // '0' same value, '10' meaningful bits inside the previous window,
+        // '11' new window: 5 bits leading zeros, 5 bits length - 1, then the bits
+        uint32_t x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.Write(0, 1);
+            continue;
+        }
+        int lead = __builtin_clz(x);
+        int trail = __builtin_ctz(x);
+        if (leading >= 0 && lead >= leading && trail >= trailing) {
+            writer.Write(0x2, 2);
+            writer.Write(x >> trailing, 32 - leading - trailing);
+        } else {
+            leading = lead;
+            trailing = trail;
+            int length = 32 - lead - trail;
+            writer.Write(0x3, 2);
+            writer.Write(lead, 5);
+            writer.Write(length - 1, 5);
+            writer.Write(x >> trail, length);
+        }
+    }
+    writer.Flush();
+}
+
+bool DecodeFloatBlock(const uint8_t* data, size_t size, size_t count, int64_t* times, float* values) {
+    BitReader reader(data, size);
+    int64_t last_delta = 0;
+    int64_t time = 0;
+    uint32_t previous = 0;
+    int leading = 0, trailing = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        time = ReadTimestamp(reader, i, time, last_delta);
+        times[i] = time;
+
+        if (i == 0) {
+            previous = reader.Read(32);
+        } else if (reader.Read(1) == 1) {
+            if (reader.Read(1) == 1) {
+                leading = (int)reader.Read(5);
+                trailing = 32 - leading - ((int)reader.Read(5) + 1);
+                // Only a corrupt block has leading + length past 32 bits
+                if (trailing < 0) return false;
+            }
+            previous ^= reader.Read(32 - leading - trailing) << trailing;
+        }
+        memcpy(&values[i], &previous, sizeof(previous));
+    }
+    return !reader.Overrun();
+}
+
+void EncodeCounterBlock(const int64_t* times, const uint64_t* values, size_t count, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    int64_t last_delta = 0;
+    for (size_t i = 0; i < count; ++i) {
+        WriteTimestamp(writer, i, times, last_delta);
+    }
+    writer.Flush();
+
+    // Byte-aligned LEB128 varints after the timestamps; counters that reset go negative
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value = ZigZag((int64_t)(values[i] - previous));
+        previous = values[i];
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+}
+
+bool DecodeCounterBlock(const uint8_t* data, size_t size, size_t count, int64_t* times, uint64_t* values) {
+    BitReader reader(data, size);
+    int64_t last_delta = 0;
+    int64_t time = 0;
+    for (size_t i = 0; i < count; ++i) {
+        time = ReadTimestamp(reader, i, time, last_delta);
+        times[i] = time;
+    }
+    if (reader.Overrun()) return false;
+
+    size_t offset = reader.BytesUsed();
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value = 0;
+        int shift = 0;
+        while (true) {
+            if (offset >= size || shift > 63) return false;
+            uint8_t byte = data[offset++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+        previous += (uint64_t)UnZigZag(value);
+        values[i] = previous;
+    }
+    return true;
+}
+
@@ -0,0 +1,210 @@
+#include "collector.h"
+
+// SnapshotBuffer Implementation
+const int SnapshotBuffer::SLOT_COUNT;
+
+MonitorSnapshot* SnapshotBuffer::BeginWrite() {
+    MonitorSnapshot* published = current.load();
+    for (auto& slot : slots) {
+        // A reader that pinned a stale slot re-checks the pointer and backs off
+        // before reading, so an unpinned slot is safe to overwrite
+        if (&slot != published && slot.refs.load() == 0) return &slot;
+    }
+    return nullptr;
+}
+
+void SnapshotBuffer::Publish(MonitorSnapshot* snapshot) {
+    current.store(snapshot);
+}
+
+const MonitorSnapshot* SnapshotBuffer::Acquire() {
+    while (true) {
+        MonitorSnapshot* snapshot = current.load();
+        if (!snapshot) return nullptr;
+        snapshot->refs.fetch_add(1);
+        if (current.load() == snapshot) return snapshot;
+        snapshot->refs.fetch_sub(1);
+    }
+}
+
+void SnapshotBuffer::Release(const MonitorSnapshot* snapshot) {
+    if (snapshot) snapshot->refs.fetch_sub(1);
+}
+
+// Collector Implementation
+Collector::Collector() : memory_manager(&const_cast<SystemInfo&>(system_manager.GetSystemInfo())) {
+    system_manager.Initialize();
+    
+    config.Load(Config::DefaultPath());
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        std::string key = std::string("interval.") + CollectorScheduler::Name(c);
+        scheduler.SetInterval(c, config.GetInt(key, CollectorScheduler::DefaultInterval(c)));
+    }
+    system_manager.SetTemperatureZone(config.GetInt("thermal.zone", 0));
+    system_manager.OpenHistory(config.Get("history.dir", HistoryStore::DefaultDirectory()));
+    scheduler.Start(CollectorScheduler::Clock::now());
+    memory_manager.SetEventNotify([this] { Wake(); });
+    
+    PublishSnapshot();
+}
+
+Collector::~Collector() {
+    // The listener outlives wake_mutex; stop it calling back first
+    memory_manager.SetEventNotify(nullptr);
+}
+
+void Collector::Update() {
+    bool all[COLLECTOR_COUNT];
+    std::fill(all, all + COLLECTOR_COUNT, true);
+    RunCollectors(all);
+}
+
+void Collector::RunCollectors(const bool due[COLLECTOR_COUNT]) {
+    bool any = false;
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        if (!due[c]) continue;
+        {
+            ScopedLatency timer(collector_latency[c]);
+            switch (c) {
+                case COLLECT_CPU: system_manager.UpdateCPU(); break;
+                case COLLECT_THERMAL: system_manager.UpdateThermal(); break;
+                case COLLECT_MEMORY: memory_manager.UpdateMemoryInfo(); break;
+                case COLLECT_PROCESSES: memory_manager.UpdateProcesses(); break;
+                case COLLECT_DISK: memory_manager.UpdateDiskInfo(); break;
+                case COLLECT_NETWORK: network_manager.Update(); break;
+            }
+        }
+        RecordSeries(c);
+        collector_versions[c]++;
+        any = true;
+    }
+    if (!any) return;
+    
+    self_usage.Update();
+    ScopedLatency timer(publish_latency);
+    PublishSnapshot();
+}
+
+CollectorScheduler::Clock::time_point Collector::RunScheduled() {
+    bool refresh;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        refresh = update_requested;
+        update_requested = false;
+        wake_requested = false;
+    }
+    
+    auto now = CollectorScheduler::Clock::now();
+    if (scheduler.TakeIntervalsChanged()) {
+        scheduler.Reschedule(now);
+        SaveSettings();
+    }
+    
+    bool due[COLLECTOR_COUNT] = {};
+    scheduler.PopDue(now, due);
+    if (refresh) std::fill(due, due + COLLECTOR_COUNT, true);
+    
+    // Process events are applied as they arrive instead of waiting for the next
+    // scan; a scan that is due drains them itself
+    bool events = !due[COLLECT_PROCESSES] && now >= next_event_drain && memory_manager.HasPendingEvents();
+    if (events) {
+        {
+            ScopedLatency timer(collector_latency[COLLECT_PROCESSES]);
+            memory_manager.ProcessEvents();
+        }
+        collector_versions[COLLECT_PROCESSES]++;
+        next_event_drain = now + std::chrono::milliseconds(EVENT_INTERVAL_MS);
+    }
+    
+    if (std::find(due, due + COLLECTOR_COUNT, true) != due + COLLECTOR_COUNT) {
+        RunCollectors(due);
+    } else if (events) {
+        ScopedLatency timer(publish_latency);
+        PublishSnapshot();
+    }
+    
+    auto deadline = scheduler.NextDeadline();
+    if (memory_manager.HasPendingEvents()) deadline = std::min(deadline, next_event_drain);
+    return deadline;
+}
+
+void Collector::RecordSeries(int collector) {
+    const SystemInfo& info = system_manager.GetSystemInfo();
+    double now = WallSeconds();
+    if (collector == COLLECT_MEMORY) {
+        system_manager.RecordSeries("memory", now, info.memory_usage);
+        system_manager.RecordSeries("swap", now, info.swap_usage);
+    } else if (collector == COLLECT_DISK) {
+        system_manager.RecordSeries("disk", now, info.disk_usage);
+    } else if (collector == COLLECT_NETWORK) {
+        char name[32];
+        for (const NetworkInterface& iface : network_manager.GetNetworkInterfaces()) {
+            snprintf(name, sizeof(name), "rx.%s", iface.name.c_str());
+            system_manager.RecordSeries(name, now, (float)iface.rx_rate);
+            snprintf(name, sizeof(name), "tx.%s", iface.name.c_str());
+            system_manager.RecordSeries(name, now, (float)iface.tx_rate);
+        }
+    }
+}
+
+void Collector::WaitUntil(CollectorScheduler::Clock::time_point deadline) {
+    // Absolute deadline, like sleep_until, but RequestUpdate()/Wake() cut it short
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    wake_cv.wait_until(lock, deadline, [this] { return wake_requested; });
+}
+
+void Collector::SaveSettings() {
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        config.SetInt(std::string("interval.") + CollectorScheduler::Name(c), scheduler.GetInterval(c));
+    }
+    config.Save();
+}
+
+void Collector::PublishSnapshot() {
+    // Only the collector thread writes; if every spare slot is still pinned
+    // by a frame the tick is simply not published
+    MonitorSnapshot* snapshot = snapshots.BeginWrite();
+    if (!snapshot) return;
+    
+    // A slot is a few publishes old; only sections whose collector ran since are copied
+    bool stale[COLLECTOR_COUNT];
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        stale[c] = snapshot->versions[c] != collector_versions[c];
+        snapshot->versions[c] = collector_versions[c];
+    }
+    
+    system_manager.WriteSnapshot(*snapshot, stale);
+    memory_manager.WriteSnapshot(*snapshot, stale);
+    network_manager.WriteSnapshot(*snapshot, stale);
+    snapshot->self = self_usage.GetStats();
+    snapshot->time = WallSeconds();
+    snapshot->sequence = ++snapshot_sequence;
+    snapshots.Publish(snapshot);
+    {
+        std::lock_guard<std::mutex> lock(publish_mutex);
+        published_sequence = snapshot_sequence;
+    }
+    publish_cv.notify_all();
+}
+
+void Collector::WaitForSnapshot(uint64_t sequence, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(publish_mutex);
+    publish_cv.wait_for(lock, timeout, [&] { return published_sequence > sequence; });
+}
+
+void Collector::RequestUpdate() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        update_requested = true;
+        wake_requested = true;
+    }
+    wake_cv.notify_one();
+}
+
+void Collector::Wake() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_requested = true;
+    }
+    wake_cv.notify_one();
+}
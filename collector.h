@@ -0,0 +1,1369 @@
+#ifndef SYSMON_COLLECTOR_H
+#define SYSMON_COLLECTOR_H
+
+// Data collection only: no SDL, OpenGL or ImGui. Linked into the UI and into
+// the headless sysmon-agent as libsysmon.a.
+#include <vector>
+#include <string>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#include <pdh.h>
+#include <iphlpapi.h>
+#pragma comment(lib, "pdh.lib")
+#pragma comment(lib, "iphlpapi.lib")
+#else
+#include <unistd.h>
+#include <sys/utsname.h>
+#include <sys/sysinfo.h>
+#include <dirent.h>
+#include <pwd.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <sys/statvfs.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+// Data structures
+struct ProcessInfo {
+    int pid;
+    std::string name;
+    std::string state;
+    float cpu_usage;
+    float memory_usage;
+    uint64_t starttime = 0;         // Distinguishes reused pids
+    uint64_t cpu_ticks = 0;         // utime + stime at the previous scan
+    bool cpu_sampled = false;       // cpu_ticks holds a previous sample
+    bool alive = false;             // False once the row is tombstoned
+    uint32_t seen_generation = 0;
+};
+
+// Persistent process rows keyed by (pid, starttime). Rows are updated in
+// place across ticks, so a row index identifies the same process for as long
+// as it lives. Exited processes are tombstoned and their slots reused.
+class ProcessTable {
+private:
+    struct IndexEntry {
+        int pid;
+        uint32_t row;
+        uint64_t starttime;
+    };
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+    static const uint32_t TOMBSTONE = 0xFFFFFFFEu;
+
+    std::vector<ProcessInfo> rows;
+    std::vector<uint32_t> free_rows;
+    std::vector<IndexEntry> index;  // Open addressing, linear probing
+    size_t index_used = 0;          // Live entries plus tombstones
+    size_t live_count = 0;
+    uint32_t generation = 0;
+    uint32_t membership_version = 0;
+
+    size_t Probe(int pid, uint64_t starttime) const;
+    void Rehash(size_t capacity);
+
+public:
+    ProcessTable();
+
+    // A scan brackets its Upsert() calls with BeginUpdate()/EndUpdate();
+    // rows not seen in between are tombstoned by EndUpdate()
+    void BeginUpdate();
+    ProcessInfo& Upsert(int pid, uint64_t starttime, bool* inserted = nullptr);
+    void EndUpdate();
+
+    int Find(int pid, uint64_t starttime) const;
+    // Live row for pid with the latest starttime, or -1
+    int FindPid(int pid) const;
+    void Remove(uint32_t row);
+    void Clear();
+
+    const std::vector<ProcessInfo>& Rows() const { return rows; }
+    size_t LiveCount() const { return live_count; }
+    // Bumped whenever rows are inserted or tombstoned
+    uint32_t MembershipVersion() const { return membership_version; }
+};
+
+struct NetworkInterface {
+    std::string name;
+    std::string description;
+    std::string ipv4;
+    int type = 0;
+    int ifindex = 0;
+    std::string ipv6;
+    bool operational_status = false;
+    std::string mac_address;
+    uint32_t speed_mbps = 0;
+    uint64_t rx_rate = 0, rx_bytes = 0, rx_packets = 0, rx_errs = 0, rx_drop = 0, rx_fifo = 0, rx_frame = 0, rx_compressed = 0, rx_multicast = 0;
+    uint64_t tx_rate = 0, tx_bytes = 0, tx_packets = 0, tx_errs = 0, tx_drop = 0, tx_fifo = 0, tx_colls = 0, tx_carrier = 0, tx_compressed = 0;
+    uint64_t rx_packet_rate = 0, tx_packet_rate = 0;
+};
+
+// One /sys/class/thermal/thermal_zoneN reading
+struct ThermalZone {
+    int zone = 0;
+    float temperature = 0.0f;
+};
+
+struct SystemInfo {
+    std::string os_type;
+    std::string username;
+    std::string hostname;
+    int total_processes = 0;
+    int running_processes = 0;
+    int sleeping_processes = 0;
+    int zombie_processes = 0;
+    int stopped_processes = 0;
+    std::string cpu_type;
+    float cpu_usage = 0.0f;
+    float memory_usage = 0.0f;
+    float swap_usage = 0.0f;
+    float disk_usage = 0.0f;
+    float temperature = 0.0f;          // The configured zone (thermal.zone, default 0)
+    std::vector<ThermalZone> thermal_zones;
+    int fan_speed = 0;
+    bool fan_active = false;
+    uint64_t total_memory = 0;
+    uint64_t used_memory = 0;
+    uint64_t total_swap = 0;
+    uint64_t used_swap = 0;
+    uint64_t total_disk = 0;
+    uint64_t used_disk = 0;
+};
+
+#ifndef _WIN32
+// Fields of /proc/[pid]/stat used by the process table
+struct ProcStat {
+    int pid = 0;
+    char comm[64] = "";
+    char state = '?';
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    int64_t cutime = 0;
+    int64_t cstime = 0;
+    uint64_t starttime = 0;
+    uint64_t vsize = 0;
+    int64_t rss = 0;
+};
+
+// Fixed set of threads for running the shards of a parallel loop
+class WorkerPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    const std::function<void(int)>* job = nullptr;
+    int job_shards = 0;
+    int next_shard = 0;
+    int pending_shards = 0;
+    uint64_t job_id = 0;
+    bool stopping = false;
+
+    void WorkerLoop();
+    void RunShards(std::unique_lock<std::mutex>& lock);
+
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void Resize(int thread_count);
+    int Size() const { return (int)threads.size(); }
+    // Runs fn(0) .. fn(shards - 1) on the pool and the calling thread and
+    // returns once every shard has finished
+    void Run(int shards, const std::function<void(int)>& fn);
+};
+
+// Process lifecycle event from the netlink proc connector
+struct ProcEvent {
+    enum Type { FORK, EXEC, EXIT };
+    Type type;
+    int pid;
+    uint64_t timestamp_ns;      // Nanoseconds since boot
+    int exit_code = 0;
+    bool has_stat = false;      // stat was read while the process was alive
+    ProcStat stat;
+};
+
+// Subscribes to PROC_EVENT_FORK/EXEC/EXIT over NETLINK_CONNECTOR on its own
+// thread and queues them for the collector. Subscribing needs
+// CAP_NET_ADMIN; without it Start() fails and the caller keeps polling.
+class ProcEventListener {
+public:
+    // Past this many queued events new ones are dropped; the next scan reconciles
+    static const size_t MAX_PENDING = 65536;
+
+private:
+    int sock = -1;
+    int proc_fd = -1;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex mutex;
+    std::vector<ProcEvent> pending;
+    std::atomic<bool> has_pending{false};
+    std::atomic<uint64_t> dropped{0};       // Socket overruns plus events past MAX_PENDING
+    std::function<void()> notify;           // Guarded by mutex
+    std::string error;
+
+    void ListenLoop();
+
+public:
+    ProcEventListener() = default;
+    ~ProcEventListener();
+    ProcEventListener(const ProcEventListener&) = delete;
+    ProcEventListener& operator=(const ProcEventListener&) = delete;
+
+    bool Start();
+    void Stop();
+    bool IsActive() const { return running; }
+    const std::string& GetError() const { return error; }
+    // Moves the queued events into out (previous contents are discarded)
+    void Drain(std::vector<ProcEvent>& out);
+    bool HasPending() const { return has_pending.load(std::memory_order_relaxed); }
+    uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+    // Called on the listener thread when events arrive on an empty queue
+    void SetNotify(std::function<void()> callback);
+};
+
+// Interface list from rtnetlink: one RTM_GETLINK dump (IFLA_STATS64) and
+// one RTM_GETADDR dump per tick, with no text parsing or per-interface calls
+class RouteNetlink {
+private:
+    int sock = -1;
+    int events_sock = -1;                   // RTNLGRP_LINK/IPV4_IFADDR/IPV6_IFADDR multicast
+    uint32_t seq = 0;
+    std::vector<char> buffer;
+    std::vector<int> index_to_position;     // ifindex -> position in the list
+
+    bool SendDump(int type, int family);
+    template <typename Fn> bool ReceiveDump(Fn on_message);
+
+public:
+    RouteNetlink() = default;
+    ~RouteNetlink();
+    RouteNetlink(const RouteNetlink&) = delete;
+    RouteNetlink& operator=(const RouteNetlink&) = delete;
+
+    bool Open();
+    void Close();
+    bool IsOpen() const { return sock >= 0; }
+    // Rewrites ifaces in place (entries are reused to keep their string capacity)
+    bool DumpLinks(std::vector<NetworkInterface>& ifaces);
+    bool DumpAddresses(std::vector<NetworkInterface>& ifaces);
+
+    // Link and address change notifications, drained without blocking
+    bool Subscribe();
+    bool IsSubscribed() const { return events_sock >= 0; }
+    // Appends the ifindex of every changed link; returns false if events were lost
+    bool PollEvents(std::vector<int>& changed_links, bool& addresses_changed);
+};
+
+// Where the collectors find procfs and sysfs (procfs.cpp): /proc and /sys,
+// unless SYSMON_PROC_ROOT/SYSMON_SYS_ROOT or the root.proc/root.sys settings
+// point them at a synthetic tree written by sysmon-gen-proctree. Managers
+// build their paths when constructed, so change the roots before that.
+const std::string& ProcRoot();
+const std::string& SysRoot();
+void SetSystemRoots(const std::string& proc_root, const std::string& sys_root);
+// False for a synthetic tree: netlink and the proc connector only describe the host
+bool UsingHostRoots();
+
+// procfs readers (procfs.cpp)
+bool ParseProcStat(const char* buf, size_t len, ProcStat& out);
+bool ReadProcStat(int proc_fd, const char* pid_name, ProcStat& out);
+bool ReadProcStat(int proc_fd, int pid, ProcStat& out);
+// Collects the numeric entries of a /proc directory fd with getdents64
+bool ListProcPids(int proc_fd, std::vector<int>& pids);
+// Reads the stat file of every pid, split into `shards` contiguous slices
+// run on `pool`; results[i] receives the stats parsed by shard i
+void ScanProcStats(int proc_fd, const std::vector<int>& pids, WorkerPool& pool, int shards,
+                   std::vector<std::vector<ProcStat>>& results);
+
+// Keeps fixed /proc and /sys files open and re-reads them with pread() at
+// offset 0. A source is reopened when a read fails or when the path stops
+// resolving to the inode we hold (e.g. a hwmon device was hot-plugged).
+class SourceCache {
+private:
+    struct Source {
+        std::string path;
+        int fd = -1;
+        dev_t dev = 0;
+        ino_t ino = 0;
+        int reads_until_check = 0;
+    };
+    std::vector<Source> sources;
+    static const int REVALIDATE_INTERVAL = 16;
+
+    bool Open(Source& source);
+    void Close(Source& source);
+
+public:
+    SourceCache() = default;
+    ~SourceCache();
+    SourceCache(const SourceCache&) = delete;
+    SourceCache& operator=(const SourceCache&) = delete;
+
+    int Register(const std::string& path);
+    // Reads the whole file into buf (grown as needed, NUL-terminated).
+    // Returns the number of bytes read, or -1 if the source is unavailable.
+    ssize_t Read(int handle, std::vector<char>& buf);
+    void Invalidate(int handle);
+};
+#endif
+
+// Up to two contiguous runs of ring storage, oldest value first
+template <typename T>
+struct RingSpans {
+    const T* first = nullptr;
+    size_t first_size = 0;
+    const T* second = nullptr;
+    size_t second_size = 0;
+    const std::atomic<uint64_t>* head = nullptr;    // The ring's push count
+    uint64_t safe_until = 0;                        // Push count at which the oldest slot is reused
+
+    size_t size() const { return first_size + second_size; }
+    bool empty() const { return size() == 0; }
+    const T& operator[](size_t i) const { return i < first_size ? first[i] : second[i - first_size]; }
+    const T& back() const { return (*this)[size() - 1]; }
+    // Check after reading: true when the producer may have written over what
+    // was read, in which case it must be thrown away
+    bool Overwritten() const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return head && head->load(std::memory_order_relaxed) >= safe_until;
+    }
+};
+
+// Fixed-capacity single-producer/single-consumer ring for time series. Push
+// never allocates or moves data. A reader takes Spans() at some head position
+// and may keep using them while the producer writes up to SLACK more values,
+// because the SLACK spare slots are never part of what a reader sees. A
+// reader that holds spans longer checks Overwritten() after reading.
+template <typename T>
+class RingBuffer {
+private:
+    std::vector<T> data;                // capacity + SLACK slots
+    size_t capacity = 0;
+    std::atomic<uint64_t> head{0};      // Values pushed so far
+
+public:
+    static const size_t SLACK = 64;
+
+    explicit RingBuffer(size_t capacity = 0) { Reset(capacity); }
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // Not safe against concurrent readers
+    void Reset(size_t new_capacity) {
+        capacity = new_capacity;
+        data.assign(capacity > 0 ? capacity + SLACK : 0, T());
+        head.store(0);
+    }
+
+    void Push(const T& value) {
+        if (data.empty()) return;
+        uint64_t h = head.load(std::memory_order_relaxed);
+        data[h % data.size()] = value;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    size_t Capacity() const { return capacity; }
+    uint64_t Head() const { return head.load(std::memory_order_acquire); }
+    size_t Size() const { return (size_t)std::min<uint64_t>(Head(), capacity); }
+
+    // The newest min(count, Size()) values as at most two spans
+    RingSpans<T> Spans(size_t count = (size_t)-1) const {
+        RingSpans<T> spans;
+        uint64_t h = Head();
+        spans.head = &head;
+        // Push h + SLACK is the first to land on a slot the spans cover
+        spans.safe_until = h + SLACK;
+        count = (size_t)std::min<uint64_t>(std::min<uint64_t>(count, capacity), h);
+        if (count == 0) return spans;
+
+        size_t start = (size_t)((h - count) % data.size());
+        spans.first = data.data() + start;
+        spans.first_size = std::min(count, data.size() - start);
+        if (spans.first_size < count) {
+            spans.second = data.data();
+            spans.second_size = count - spans.first_size;
+        }
+        return spans;
+    }
+};
+
+// A raw sample (count 1) or a rollup of every sample in [time, time + width)
+struct HistoryBucket {
+    double time = 0.0;          // Unix seconds at the start of the bucket
+    float min = 0.0f;
+    float max = 0.0f;
+    double sum = 0.0;
+    uint32_t count = 0;
+
+    void Add(float value) {
+        if (count == 0 || value < min) min = value;
+        if (count == 0 || value > max) max = value;
+        sum += value;
+        count++;
+    }
+    void Merge(const HistoryBucket& other) {
+        if (other.count == 0) return;
+        if (count == 0 || other.min < min) min = other.min;
+        if (count == 0 || other.max > max) max = other.max;
+        sum += other.sum;
+        count += other.count;
+    }
+    float Average() const { return count > 0 ? (float)(sum / count) : 0.0f; }
+};
+
+// Raw samples plus 10 s, 1 min and 10 min rollups (history.cpp). Every tier
+// is a fixed ring, so a week of history costs the same memory as an hour.
+class TieredHistory {
+public:
+    enum Tier { TIER_RAW, TIER_10S, TIER_1M, TIER_10M, TIER_COUNT };
+    static const double TIER_SECONDS[TIER_COUNT];
+    static const size_t TIER_CAPACITY[TIER_COUNT];
+
+    // What a snapshot keeps: the completed buckets of each tier and the open one
+    struct View {
+        RingSpans<HistoryBucket> tiers[TIER_COUNT];
+        HistoryBucket open[TIER_COUNT];
+
+        // Finest tier that covers the window in at most max_points points
+        int PickTier(double window_seconds, size_t max_points) const;
+        bool empty() const { return tiers[TIER_RAW].empty(); }
+        bool Overwritten(int tier) const { return tiers[tier].Overwritten(); }
+        float Latest() const { return empty() ? 0.0f : tiers[TIER_RAW].back().max; }
+    };
+
+private:
+    RingBuffer<HistoryBucket> tiers[TIER_COUNT];
+    HistoryBucket open[TIER_COUNT];
+
+    // Folds a bucket into the open buckets of tiers [first_tier, TIER_COUNT)
+    void Roll(int first_tier, const HistoryBucket& bucket, HistoryBucket* completed);
+
+public:
+    TieredHistory();
+    // O(1): one raw push and at most one completed bucket per tier. A 10 s
+    // bucket that closes is copied to *completed and true is returned.
+    bool Add(double time, float value, HistoryBucket* completed = nullptr);
+    // Replays a stored 10 s bucket; call oldest first, before any Add
+    void Restore(const HistoryBucket& bucket);
+    View GetView() const;
+};
+
+// Wall-clock Unix time in seconds, the time base of every history
+double WallSeconds();
+
+// Text output for the exporters: to_chars straight into a growing buffer,
+// no locale and no temporary strings
+inline void AppendText(std::vector<char>& out, const char* text, size_t len) {
+    out.insert(out.end(), text, text + len);
+}
+
+inline void AppendText(std::vector<char>& out, const char* text) {
+    AppendText(out, text, strlen(text));
+}
+
+inline void AppendText(std::vector<char>& out, const std::string& text) {
+    AppendText(out, text.data(), text.size());
+}
+
+template <typename T>
+inline void AppendNumber(std::vector<char>& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    AppendText(out, buffer, result.ptr - buffer);
+}
+
+inline void AppendFixed(std::vector<char>& out, double value, int precision) {
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    AppendText(out, buffer, result.ptr - buffer);
+}
+
+// "1.50 MB": two decimals in steps of 1024
+inline void AppendBytes(std::vector<char>& out, uint64_t bytes) {
+    static const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    int unit = 0;
+    double value = (double)bytes;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        unit++;
+    }
+    AppendFixed(out, value, 2);
+    out.push_back(' ');
+    AppendText(out, units[unit]);
+}
+
+// Render-ready text for a snapshot, formatted on the collector thread. Each
+// string is nul-terminated in one buffer that lives as long as the snapshot
+// slot, so once the buffer has grown to size a tick allocates nothing and
+// the views draw the text as it is.
+struct TextRef {
+    uint32_t offset = 0xFFFFFFFFu;
+};
+
+class TextArena {
+private:
+    std::vector<char> buffer;
+
+    TextRef Finish(size_t offset) {
+        buffer.push_back('\0');
+        return TextRef{(uint32_t)offset};
+    }
+
+public:
+    void Clear() { buffer.clear(); }
+    const char* Get(TextRef ref) const { return ref.offset < buffer.size() ? buffer.data() + ref.offset : ""; }
+
+    template <typename T>
+    TextRef AddNumber(T value) {
+        size_t offset = buffer.size();
+        AppendNumber(buffer, value);
+        return Finish(offset);
+    }
+    // Display precisions (up to 3 decimals) go through integer math, several
+    // times faster than to_chars for floating point
+    TextRef AddFixed(double value, int precision) {
+        static const int64_t scales[] = {1, 10, 100, 1000};
+        size_t offset = buffer.size();
+        double scaled_value = precision >= 0 && precision <= 3 ? value * scales[precision] : 0.0;
+        // Near-ties need the exact binary value to round like printf
+        if (precision < 0 || precision > 3 || !(std::fabs(scaled_value) < 1e15) ||
+            std::fabs(scaled_value - std::floor(scaled_value) - 0.5) < 1e-6) {
+            AppendFixed(buffer, value, precision);
+            return Finish(offset);
+        }
+        int64_t scaled = std::llround(scaled_value);
+        if (std::signbit(value)) {
+            buffer.push_back('-');
+            scaled = -scaled;
+        }
+        AppendNumber(buffer, scaled / scales[precision]);
+        if (precision > 0) {
+            buffer.push_back('.');
+            int64_t fraction = scaled % scales[precision];
+            for (int64_t scale = scales[precision] / 10; scale > 0; scale /= 10) {
+                buffer.push_back((char)('0' + fraction / scale % 10));
+            }
+        }
+        return Finish(offset);
+    }
+    TextRef AddBytes(uint64_t bytes) {
+        size_t offset = buffer.size();
+        AppendBytes(buffer, bytes);
+        return Finish(offset);
+    }
+    TextRef AddRate(uint64_t bytes_per_sec) {
+        size_t offset = buffer.size();
+        AppendBytes(buffer, bytes_per_sec);
+        AppendText(buffer, "/s", 2);
+        return Finish(offset);
+    }
+    // "used / total"
+    TextRef AddUsage(uint64_t used, uint64_t total) {
+        size_t offset = buffer.size();
+        AppendBytes(buffer, used);
+        AppendText(buffer, " / ", 3);
+        AppendBytes(buffer, total);
+        return Finish(offset);
+    }
+};
+
+// Cells of a process table row
+struct ProcessText {
+    TextRef pid, cpu, memory;
+};
+
+// Cells of an interface's RX and TX table rows
+struct InterfaceText {
+    TextRef rx_bytes, tx_bytes, rx_rate, tx_rate;
+    TextRef rx_counts[6];   // packets, errs, drop, fifo, frame, compressed
+    TextRef tx_counts[6];   // packets, errs, drop, fifo, colls, carrier
+};
+
+// Sums over every interface but loopback
+struct NetworkTotalsText {
+    TextRef rx_bytes, tx_bytes, rx_rate, tx_rate, traffic;
+};
+
+// Gorilla-style series blocks (codec.cpp). Timestamps (ms) are stored as
+// delta-of-delta, floats XORed against the previous value, counters as
+// zigzag varint deltas. Encoders append to out; the caller keeps the point
+// count and decodes a whole block at a time.
+void EncodeFloatBlock(const int64_t* times, const float* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeFloatBlock(const uint8_t* data, size_t size, size_t count, int64_t* times, float* values);
+void EncodeCounterBlock(const int64_t* times, const uint64_t* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeCounterBlock(const uint8_t* data, size_t size, size_t count, int64_t* times, uint64_t* values);
+
+// One stored 10 s bucket. The checksum covers every byte before it, so a
+// record torn by a crash or power loss never validates.
+struct HistoryRecord {
+    double time = 0.0;
+    float min = 0.0f;
+    float max = 0.0f;
+    float average = 0.0f;
+    uint32_t count = 0;
+    uint16_t metric = 0;            // Slot in the segment's metric table
+    uint16_t reserved = 0;
+    uint32_t checksum = 0;
+
+    uint32_t Checksum() const;
+    bool IsValid() const { return count > 0 && checksum == Checksum(); }
+};
+
+// Fixed index at the start of every segment file. Version 1 held 16 names of
+// 16 bytes; such headers are widened in place when opened for appending.
+struct HistorySegmentHeader {
+    static const int MAX_METRICS = 120;
+    static const int NAME_SIZE = 32;
+    static const int V1_MAX_METRICS = 16;
+    static const int V1_NAME_SIZE = 16;
+    static const uint32_t NO_RECORD = 0xFFFFFFFFu;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t capacity;              // Records the file has room for
+    uint32_t metric_count;
+    int64_t day;                    // Days since the Unix epoch (UTC)
+    uint32_t hour_first[24];        // First record of each hour, NO_RECORD if none
+    char metric_names[MAX_METRICS][NAME_SIZE];
+};
+
+// Append-only store of 10 s history buckets (history.cpp). There is one
+// memory-mapped segment per UTC day: a header page, then fixed-size records.
+// Loading maps the segments and walks the records in place; the first record
+// that fails its checksum ends the segment and is cleared before appending.
+// Once a day is over its segment is sealed: rewritten as one compressed
+// series block per metric (see EncodeFloatBlock) and the segment removed.
+class HistoryStore {
+public:
+    static const int RETENTION_DAYS = 8;
+    static const size_t HEADER_SIZE = 4096;
+    // A day of 10 s buckets for 64 series; sparse, so unused room costs no disk
+    static const uint32_t SEGMENT_CAPACITY = 24 * 360 * 64;
+
+private:
+    struct Segment {
+        int fd = -1;
+        char* map = nullptr;
+        size_t map_size = 0;
+        int64_t day = 0;
+        uint32_t count = 0;
+        int slots[HistorySegmentHeader::MAX_METRICS] = {};  // Metric id to header slot
+
+        HistorySegmentHeader* Header() const { return (HistorySegmentHeader*)map; }
+        HistoryRecord* Records() const { return (HistoryRecord*)(map + HEADER_SIZE); }
+    };
+
+    std::string directory;
+    std::vector<std::string> metric_names;
+    Segment segment;                // Today's segment, opened on the first append
+    bool full_reported = false;
+    bool busy_reported = false;     // Another process holds the segment lock
+
+    std::string SegmentPath(int64_t day, const char* extension = ".hist") const;
+    bool MapSegment(Segment& target, int64_t day, bool writable);
+    // Finds metric m in the segment's name table, adding it when writable
+    void MapMetric(Segment& target, size_t m, bool writable);
+    void UnmapSegment(Segment& target);
+    void PruneSegments(int64_t today);
+    // Compresses a past day's segment into a sealed file, unless a writer holds it
+    void SealSegment(int64_t day);
+    size_t LoadSealed(int64_t day, double since, const std::function<void(int, const HistoryBucket&)>& restore);
+
+public:
+    HistoryStore() = default;
+    ~HistoryStore() { Close(); }
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    static std::string DefaultDirectory();
+
+    bool Open(const std::string& dir, const std::vector<std::string>& metrics);
+    void Close();
+    bool IsOpen() const { return !directory.empty(); }
+
+    // Calls restore(metric, bucket) for every stored bucket at or after since,
+    // oldest first. Returns the number of buckets replayed.
+    size_t Load(double since, const std::function<void(int, const HistoryBucket&)>& restore);
+    bool Append(int metric, const HistoryBucket& bucket);
+    // Registers another series after Open; returns its metric id, or -1 once
+    // MAX_METRICS names are taken
+    int AddMetric(const std::string& name);
+};
+
+static_assert(sizeof(HistorySegmentHeader) <= HistoryStore::HEADER_SIZE, "segment header overflows its page");
+
+// /proc/stat times for the whole machine (slot 0) and each core (slots 1..n),
+// kept as structure-of-arrays so the percentage pass vectorizes
+struct CPUTimes {
+    enum Field { USER, NICE, SYSTEM, IDLE, IOWAIT, IRQ, SOFTIRQ, STEAL, FIELD_COUNT };
+    // Percentages; user includes nice, guest time is already inside user
+    enum Share { SHARE_USER, SHARE_SYSTEM, SHARE_IOWAIT, SHARE_IRQ, SHARE_SOFTIRQ, SHARE_STEAL, SHARE_IDLE, SHARE_COUNT };
+
+    size_t slots = 0;
+    bool has_previous = false;
+    std::vector<uint64_t> ticks[FIELD_COUNT];
+    std::vector<uint64_t> previous[FIELD_COUNT];
+    std::vector<float> percent[SHARE_COUNT];
+    std::vector<float> busy;    // Everything except idle, iowait and steal
+    std::vector<int> ids;       // N of each slot's cpuN line (-1 for the total); offline cores leave gaps
+
+    void Resize(size_t count);
+    static const char* ShareName(int share);
+    void Compute();
+    int CoreCount() const { return slots > 0 ? (int)slots - 1 : 0; }
+    // The kernel's number for the core in the given position
+    int CoreId(int core) const { return (size_t)core + 1 < ids.size() ? ids[core + 1] : core; }
+};
+
+// key = value settings file (config.cpp)
+class Config {
+private:
+    std::map<std::string, std::string> values;
+    std::string path;
+
+public:
+    // $XDG_CONFIG_HOME/system-monitor.conf, ~/.config/system-monitor.conf or %APPDATA%
+    static std::string DefaultPath();
+    bool Load(const std::string& file);
+    // Written to a temporary file and renamed over the old one
+    bool Save() const;
+
+    std::string Get(const std::string& key, const std::string& fallback) const;
+    int GetInt(const std::string& key, int fallback) const;
+    void Set(const std::string& key, const std::string& value) { values[key] = value; }
+    void SetInt(const std::string& key, int value) { values[key] = std::to_string(value); }
+};
+
+// Log-linear latency histogram in the HDR style (overhead.cpp): 16 linear
+// sub-buckets per power of two nanoseconds, so a reported value is within
+// about 6% of what was recorded. One thread records, any thread reads;
+// recording is a bucket lookup and a few relaxed atomic updates.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_MAGNITUDE = 40;    // 2^40 ns, about 18 minutes; longer lands in the last bucket
+    static const int BUCKET_COUNT = SUB_BUCKETS + (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> counts[BUCKET_COUNT];
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+
+    static int BucketIndex(uint64_t ns) {
+        if (ns < (uint64_t)SUB_BUCKETS) return (int)ns;
+        int magnitude = 63 - __builtin_clzll(ns);
+        if (magnitude > MAX_MAGNITUDE) return BUCKET_COUNT - 1;
+        int shift = magnitude - SUB_BUCKET_BITS;
+        return SUB_BUCKETS + shift * SUB_BUCKETS + (int)((ns >> shift) & (SUB_BUCKETS - 1));
+    }
+    // Midpoint of the bucket's range
+    static uint64_t BucketValue(int index);
+
+public:
+    // Plain copy of the counters. The difference of two copies is the
+    // histogram of what was recorded in between.
+    struct Counts {
+        uint64_t buckets[BUCKET_COUNT];
+        uint64_t total;
+        uint64_t sum_ns;
+        uint64_t max_ns;
+
+        void Subtract(const Counts& base);
+        uint64_t PercentileNs(double p) const;
+    };
+
+    LatencyHistogram();
+    void Record(uint64_t ns) {
+        counts[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > max_ns.load(std::memory_order_relaxed)) max_ns.store(ns, std::memory_order_relaxed);
+    }
+    uint64_t Count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t SumNs() const { return sum_ns.load(std::memory_order_relaxed); }
+    uint64_t MaxNs() const { return max_ns.load(std::memory_order_relaxed); }
+    // p in [0, 100]; 0 when nothing was recorded
+    uint64_t PercentileNs(double p) const;
+    // Counters only grow: the metrics endpoint exports them as monotonic sums
+    void Read(Counts& out) const;
+};
+
+// Records the lifetime of the scope into a histogram
+class ScopedLatency {
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedLatency(LatencyHistogram& target) : histogram(target), start(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        histogram.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+};
+
+// The monitor's own cost (overhead.cpp)
+struct SelfStats {
+    float cpu_percent = 0.0f;   // Of one core, over the last second or so
+    double cpu_seconds = 0.0;   // Since start
+    uint64_t resident_bytes = 0;
+    int threads = 0;
+};
+
+// Samples SelfStats from /proc/self (GetProcessTimes on Windows); always
+// the real process, whatever ProcRoot() is
+class SelfUsage {
+private:
+    SelfStats stats;
+    double previous_cpu_seconds = -1.0;
+    std::chrono::steady_clock::time_point previous_sample;
+#ifndef _WIN32
+    int stat_fd = -1;
+    int statm_fd = -1;
+    double ticks_per_second = 100.0;
+    long page_size = 4096;
+#endif
+
+public:
+    static const int MIN_SAMPLE_MS = 1000;
+
+    SelfUsage();
+    ~SelfUsage();
+    SelfUsage(const SelfUsage&) = delete;
+    SelfUsage& operator=(const SelfUsage&) = delete;
+    // Re-reads at most once per MIN_SAMPLE_MS
+    void Update();
+    const SelfStats& GetStats() const { return stats; }
+};
+
+// Collectors the scheduler runs, each at its own interval
+enum CollectorId {
+    COLLECT_CPU,
+    COLLECT_THERMAL,
+    COLLECT_MEMORY,
+    COLLECT_PROCESSES,
+    COLLECT_DISK,
+    COLLECT_NETWORK,
+    COLLECTOR_COUNT
+};
+
+// Min-heap of absolute deadlines (scheduler.cpp). A collector's next deadline
+// is its previous one plus its interval, so the schedule does not drift with
+// the time collection takes; deadlines missed entirely are skipped.
+class CollectorScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static const int MIN_INTERVAL_MS = 50;
+    static const int MAX_INTERVAL_MS = 60000;
+
+private:
+    struct Deadline {
+        Clock::time_point when;
+        int collector;
+    };
+    std::vector<Deadline> heap;     // Earliest deadline on top
+    std::atomic<int> interval_ms[COLLECTOR_COUNT];
+    std::atomic<bool> intervals_changed{false};
+
+    static bool Later(const Deadline& a, const Deadline& b) { return a.when > b.when; }
+
+public:
+    CollectorScheduler();
+
+    static const char* Name(int collector);
+    static int DefaultInterval(int collector);
+
+    // Intervals may be changed from any thread; Commit() makes the collector reschedule
+    int GetInterval(int collector) const { return interval_ms[collector]; }
+    void SetInterval(int collector, int ms);
+    void Commit() { intervals_changed = true; }
+    bool TakeIntervalsChanged() { return intervals_changed.exchange(false); }
+
+    // Collector thread only
+    void Start(Clock::time_point now);
+    // Pulls deadlines changed by a shorter interval in to now + interval
+    void Reschedule(Clock::time_point now);
+    // Marks every collector due at now and queues its next deadline
+    void PopDue(Clock::time_point now, bool due[COLLECTOR_COUNT]);
+    Clock::time_point NextDeadline() const;
+};
+
+// Forward declarations
+struct MonitorSnapshot;
+class SystemManager;
+class MemoryManager;
+class NetworkManager;
+
+// System Manager Class
+class SystemManager {
+private:
+    SystemInfo system_info;
+    TieredHistory cpu_history;
+    TieredHistory fan_history;
+    TieredHistory temp_history;
+    TieredHistory cpu_share_history[CPUTimes::SHARE_COUNT];
+    CPUTimes cpu_times;
+    HistoryStore history_store;
+
+    // A series that is stored but not graphed, rolled up to 10 s here
+    struct StoredSeries {
+        std::string name;
+        int metric = -1;            // HistoryStore id, -1 when the store is full
+        HistoryBucket open;
+    };
+    std::vector<StoredSeries> stored_series;
+    int temperature_zone = 0;
+#ifndef _WIN32
+    SourceCache sources;
+    int stat_source = -1;
+    std::vector<int> temp_sources;  // One per entry of system_info.thermal_zones
+    int fan_source = -1;
+    std::vector<char> read_buffer;
+#endif
+
+public:
+    void Initialize();
+    void Update();
+    void UpdateCPU();
+    void UpdateThermal();
+    void UpdateCPUUsage();
+    void UpdateThermalInfo();
+    // Zone whose reading is the temperature; the others are still exported
+    void SetTemperatureZone(int zone) { temperature_zone = zone; }
+    
+    // Persisted series: cpu, fan, temp, then one per CPU share
+    enum { METRIC_CPU, METRIC_FAN, METRIC_TEMP, METRIC_CPU_SHARE, METRIC_COUNT = METRIC_CPU_SHARE + CPUTimes::SHARE_COUNT };
+    static std::string MetricName(int metric);
+    TieredHistory& MetricHistory(int metric);
+    // Opens the store and replays the week the 10 min tier can hold
+    void OpenHistory(const std::string& directory);
+    // Stores a sample of a series with no graph of its own (memory, disk, a
+    // core, an interface); the series is registered on first use
+    void RecordSeries(const char* name, double time, float value);
+    
+    // Getters
+    const SystemInfo& GetSystemInfo() const { return system_info; }
+    const TieredHistory& GetCPUHistory() const { return cpu_history; }
+    const TieredHistory& GetFanHistory() const { return fan_history; }
+    const TieredHistory& GetTempHistory() const { return temp_history; }
+    const CPUTimes& GetCPUTimes() const { return cpu_times; }
+    // stale[c] is set for collectors that ran since this slot was last written
+    void WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const;
+
+private:
+#ifdef _WIN32
+    void InitializeWindows();
+    void UpdateWindows();
+#else
+    void InitializeLinux();
+#endif
+};
+
+// A process exit seen through the proc connector
+struct ProcessExit {
+    int pid = 0;
+    std::string name;
+    float runtime_seconds = 0.0f;
+    int exit_code = 0;
+};
+
+// Everything the UI draws, copied out of the managers at the end of a
+// collection pass. Published read-only; the render thread never touches
+// collector state directly.
+struct MonitorSnapshot {
+    mutable std::atomic<int> refs{0};   // Frames currently reading this slot
+    uint64_t sequence = 0;
+    double time = 0.0;                          // WallSeconds() when published
+    uint64_t versions[COLLECTOR_COUNT] = {};    // Collector runs this slot reflects
+    
+    // System
+    SystemInfo system_info;
+    // Graph series point into the collector's rings; no copy is made
+    TieredHistory::View cpu_history;
+    TieredHistory::View fan_history;
+    TieredHistory::View temp_history;
+    TieredHistory::View cpu_share_history[CPUTimes::SHARE_COUNT];
+    CPUTimes cpu_times;
+    
+    // Processes, indexed like the process table rows
+    std::vector<ProcessInfo> processes;
+    uint32_t membership_version = 0;
+    int short_lived_processes = 0;
+    std::vector<ProcessExit> recent_exits;
+    size_t recent_exits_head = 0;
+    bool proc_events_active = false;
+    uint64_t proc_events_dropped = 0;
+    std::string proc_events_error;
+    
+    // Network
+    std::vector<NetworkInterface> network_interfaces;
+    const char* network_backend = "";
+    
+    // The monitor itself
+    SelfStats self;
+    
+    // Text the views draw, rebuilt with its section
+    TextArena system_text;
+    TextRef memory_usage_text, swap_usage_text, disk_usage_text;
+    TextArena process_text;
+    std::vector<ProcessText> process_cells;     // Indexed like processes
+    TextArena network_text;
+    std::vector<InterfaceText> interface_cells; // Indexed like network_interfaces
+    NetworkTotalsText network_totals;
+};
+
+// Rebuild a section's text from its data (snapshot_text.cpp); the managers'
+// WriteSnapshot calls them for the sections they copy
+void FormatSystemText(MonitorSnapshot& snapshot);
+void FormatProcessText(MonitorSnapshot& snapshot);
+void FormatNetworkText(MonitorSnapshot& snapshot);
+
+// Triple-buffered snapshots. The collector fills a slot nobody is reading and
+// publishes it with an atomic pointer swap; readers pin the current slot with
+// a reference count and re-check the pointer, so neither side takes a lock.
+class SnapshotBuffer {
+private:
+    static const int SLOT_COUNT = 3;
+    MonitorSnapshot slots[SLOT_COUNT];
+    std::atomic<MonitorSnapshot*> current{nullptr};
+
+public:
+    // A free slot to fill, or nullptr if every other slot is still being read
+    MonitorSnapshot* BeginWrite();
+    void Publish(MonitorSnapshot* snapshot);
+    // The latest published snapshot (nullptr before the first publish); must be released
+    const MonitorSnapshot* Acquire();
+    void Release(const MonitorSnapshot* snapshot);
+};
+
+// Memory Manager Class
+class MemoryManager {
+private:
+    ProcessTable processes;
+#ifndef _WIN32
+    int proc_fd = -1;
+    std::vector<int> pid_list;
+    std::vector<std::vector<ProcStat>> scan_results;
+    WorkerPool scan_pool;
+    ProcEventListener proc_events;
+    std::vector<ProcEvent> event_batch;
+    std::unordered_map<int, uint64_t> fork_times;   // pid -> fork timestamp_ns
+#endif
+    std::atomic<bool> track_process_events{true};   // Written by the UI, applied by the collector
+    bool process_events_started = false;
+    int short_lived_processes = 0;                  // Exited within SHORT_LIVED_SECONDS
+    std::vector<ProcessExit> recent_exits;          // Ring of the last EXIT_LOG_SIZE exits
+    size_t recent_exits_head = 0;
+    static const int EXIT_LOG_SIZE = 128;
+    std::atomic<int> scan_workers{1};
+    std::chrono::steady_clock::time_point last_process_scan;
+    double cpu_ticks_per_second = 100.0;
+    int cpu_count = 1;
+    std::atomic<bool> cpu_per_core{false};  // Divide CPU % by the core count instead of top-style
+    SystemInfo* system_info_ref;
+#ifndef _WIN32
+    SourceCache sources;
+    int meminfo_source = -1;
+    std::vector<char> read_buffer;
+#endif
+
+public:
+    static constexpr float SHORT_LIVED_SECONDS = 1.0f;
+
+    MemoryManager(SystemInfo* sys_info);
+    ~MemoryManager();
+    void Update();
+    void UpdateMemoryInfo();
+    void UpdateProcesses();
+    void ProcessEvents();
+    bool HasPendingEvents() const;
+    void SetEventNotify(std::function<void()> callback);
+    void UpdateDiskInfo();
+    float ProcessCPUScale();
+    void WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const;
+    
+    // Getters
+    const ProcessTable& GetProcessTable() const { return processes; }
+    int GetScanWorkers() const { return scan_workers; }
+    void SetScanWorkers(int workers);
+    bool GetTrackProcessEvents() const { return track_process_events; }
+    int GetShortLivedProcesses() const { return short_lived_processes; }
+    void SetTrackProcessEvents(bool track);
+    bool GetCPUPerCore() const { return cpu_per_core; }
+    void SetCPUPerCore(bool per_core) { cpu_per_core = per_core; }
+    int GetCPUCount() const { return cpu_count; }
+};
+
+// Network Manager Class
+class NetworkManager {
+private:
+    std::vector<NetworkInterface> network_interfaces;
+    std::vector<NetworkInterface> previous_interfaces;
+    std::chrono::steady_clock::time_point previous_update_time;
+#ifndef _WIN32
+    SourceCache sources;
+    int net_dev_source = -1;
+    std::vector<char> read_buffer;
+    RouteNetlink rtnl;
+    bool netlink_failed = false;
+
+    // Attributes that rarely change, refreshed on link events or a changed interface set
+    struct InterfaceAttributes {
+        std::string ipv4, ipv6, mac_address;
+        int type = 0;
+        bool operational_status = false;
+        bool has_speed = false;
+        uint32_t speed_mbps = 0;
+    };
+    std::unordered_map<int, InterfaceAttributes> link_attributes;   // ifindex -> attributes
+    std::unordered_map<std::string, int> name_to_index;            // /proc/net/dev fallback only
+    std::vector<int> changed_links;
+    bool attributes_dirty = true;
+    uint64_t interface_generation = 0;      // Hash of the interface set seen last refresh
+    int ticks_until_refresh = 0;
+    static const int ATTRIBUTE_REFRESH_TICKS = 30;
+#endif
+
+public:
+    NetworkManager();
+    void Update();
+    // void UpdateNetworkInfo();
+    void UpdateNetworkInterfaces();
+    void CalculateNetworkRates();
+
+    #ifdef _WIN32
+    void UpdateNetworkInterfacesWindows();
+    #else
+    void UpdateNetworkInterfacesLinux();
+    bool UpdateNetworkInterfacesNetlink();
+    void UpdateNetworkInterfacesProcfs();
+    void RefreshInterfaceAttributesProcfs();
+    uint32_t ReadLinkSpeed(const std::string& name);
+    bool AttributesExpired(uint64_t generation);
+    #endif
+    const char* GetBackendName() const;
+
+    
+    // Getters
+    const std::vector<NetworkInterface>& GetNetworkInterfaces() const { return network_interfaces; }
+    
+    void WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const;
+};
+
+// The collectors, their schedule and the published snapshots (collector.cpp).
+// Shared by the UI and the headless agent; one thread drives it with
+// RunScheduled()/WaitUntil(), any thread may read snapshots.
+class Collector {
+public:
+    // Process events between scans are applied and published at most this often
+    static const int EVENT_INTERVAL_MS = 100;
+
+private:
+    SystemManager system_manager;
+    MemoryManager memory_manager;
+    NetworkManager network_manager;
+    SnapshotBuffer snapshots;
+    uint64_t snapshot_sequence = 0;
+    uint64_t collector_versions[COLLECTOR_COUNT] = {};
+    CollectorScheduler scheduler;
+    Config config;
+    LatencyHistogram collector_latency[COLLECTOR_COUNT];
+    LatencyHistogram publish_latency;
+    SelfUsage self_usage;
+    
+    // Wakes the collector early, e.g. for the Refresh button
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool wake_requested = false;
+    bool update_requested = false;      // Run every collector on the next pass
+    CollectorScheduler::Clock::time_point next_event_drain;
+    
+    // Signals readers that follow every publish, e.g. the exporter
+    std::mutex publish_mutex;
+    std::condition_variable publish_cv;
+    uint64_t published_sequence = 0;
+
+public:
+    Collector();
+    ~Collector();
+    // Collector thread: run collectors, then publish a snapshot
+    void Update();
+    void RunCollectors(const bool due[COLLECTOR_COUNT]);
+    // Runs whatever is due and returns the next deadline
+    CollectorScheduler::Clock::time_point RunScheduled();
+    void WaitUntil(CollectorScheduler::Clock::time_point deadline);
+    void PublishSnapshot();
+    void SaveSettings();
+    // Hands the ungraphed series a collector just refreshed to the history store
+    void RecordSeries(int collector);
+    // Any thread
+    void RequestUpdate();
+    void Wake();
+    CollectorScheduler& GetScheduler() { return scheduler; }
+    // Time spent in each collector and in publishing; readable from any thread
+    LatencyHistogram& GetCollectorLatency(int collector) { return collector_latency[collector]; }
+    LatencyHistogram& GetPublishLatency() { return publish_latency; }
+    // Read before the collector thread starts; SaveSettings() writes it later
+    const Config& GetConfig() const { return config; }
+    // The latest snapshot without locking (nullptr before the first publish); must be released
+    const MonitorSnapshot* AcquireSnapshot() { return snapshots.Acquire(); }
+    void ReleaseSnapshot(const MonitorSnapshot* snapshot) { snapshots.Release(snapshot); }
+    // Blocks until a snapshot newer than sequence is published or timeout passes
+    void WaitForSnapshot(uint64_t sequence, std::chrono::milliseconds timeout);
+    
+    // Managers (collector state, not for other threads)
+    SystemManager& GetSystemManager() { return system_manager; }
+    MemoryManager& GetMemoryManager() { return memory_manager; }
+    NetworkManager& GetNetworkManager() { return network_manager; }
+};
+
+// Prometheus/OpenMetrics text on GET /metrics (metrics.cpp). A single thread
+// polls non-blocking sockets; each scrape renders the latest snapshot into
+// the connection's reused buffer, so steady-state scrapes do not allocate.
+class MetricsServer {
+public:
+    static const int DEFAULT_PORT = 9464;
+    static const int DEFAULT_TOP_PROCESSES = 20;
+    static const int MAX_CLIENTS = 16;
+    static const size_t MAX_REQUEST = 4096;
+
+private:
+    struct Client {
+        int fd = -1;
+        char request[MAX_REQUEST + 1];  // NUL-terminated
+        size_t request_len = 0;
+        char header[256];
+        size_t header_len = 0;
+        std::vector<char> body;     // Capacity kept across requests
+        size_t sent = 0;            // Bytes of header + body written so far
+        bool responding = false;
+        bool close_after = false;
+    };
+
+    Collector& collector;
+    int listen_fd = -1;
+    int wake_pipe[2] = {-1, -1};
+    std::thread thread;
+    std::atomic<bool> running{false};
+    int top_processes = DEFAULT_TOP_PROCESSES;
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<uint32_t> process_order;    // Reused for the top-N selection
+
+    void Run();
+    void Accept();
+    // Returns false when the connection should be closed
+    bool ReadRequest(Client& client);
+    bool WriteResponse(Client& client);
+    void PrepareResponse(Client& client);
+
+public:
+    explicit MetricsServer(Collector& source) : collector(source) {}
+    ~MetricsServer() { Stop(); }
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // address is a dotted IPv4 address; 127.0.0.1 keeps the endpoint local
+    bool Start(const std::string& address, int port, int max_processes);
+    // metrics.port (0, the default, leaves it off), metrics.address, metrics.top_processes
+    bool StartFromConfig(const Config& config);
+    void Stop();
+    bool IsRunning() const { return running; }
+
+    // The exposition for one snapshot; appends to out. Processes beyond the
+    // top max_processes by CPU are left out to cap the series count.
+    void RenderMetrics(const MonitorSnapshot& snapshot, std::vector<char>& out);
+};
+
+// Streaming export of every published snapshot as CSV or JSON lines
+// (export.cpp). A thread of its own follows the publishes, formats the
+// selected groups into a large buffer and writes it out, so a slow disk or
+// pipe never holds up a collection tick. Ticks are skipped, not queued, when
+// the output falls behind.
+struct ExportOptions {
+    enum Group { GROUP_SYSTEM = 1, GROUP_CORES = 2, GROUP_PROCESSES = 4, GROUP_INTERFACES = 8 };
+    static const int GROUP_COUNT = 4;
+    static const char* GroupName(int index);
+
+    std::string path;               // File, named pipe or "-" for stdout; empty disables export
+    bool csv = false;               // JSON lines otherwise
+    unsigned groups = GROUP_SYSTEM | GROUP_CORES | GROUP_INTERFACES;
+    uint64_t rotate_bytes = 64ull << 20;    // Regular files only; 0 never rotates
+    int rotate_keep = 4;            // path.1 .. path.N
+
+    // export.path, export.format (jsonl or csv), export.groups, export.rotate_mb, export.rotate_keep
+    static ExportOptions FromConfig(const Config& config);
+    // Comma-separated group names; false on an unknown name
+    bool ParseGroups(const std::string& list);
+};
+
+class SnapshotExporter {
+public:
+    static const size_t FLUSH_BYTES = 1 << 20;
+
+private:
+    Collector& collector;
+    ExportOptions options;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    int fd = -1;
+    bool rotating = false;          // Output is a regular file
+    uint64_t file_bytes = 0;
+    std::vector<char> buffer;
+    uint64_t exported_versions[COLLECTOR_COUNT] = {};
+    uint64_t skipped_ticks = 0;
+
+    void Run();
+    bool Open();
+    void Rotate();
+    // Writes the buffer out; false once the output is gone
+    bool Flush();
+    void WriteHeader();
+
+public:
+    explicit SnapshotExporter(Collector& source) : collector(source) {}
+    ~SnapshotExporter() { Stop(); }
+    SnapshotExporter(const SnapshotExporter&) = delete;
+    SnapshotExporter& operator=(const SnapshotExporter&) = delete;
+
+    bool Start(const ExportOptions& export_options);
+    void Stop();
+    bool IsRunning() const { return running; }
+
+    // Appends the records of the selected groups whose collector ran since
+    // the last export; changed[c] says whether collector c ran
+    static void FormatSnapshot(const ExportOptions& options, const MonitorSnapshot& snapshot,
+                               const bool changed[COLLECTOR_COUNT], std::vector<char>& out);
+};
+
+#endif // SYSMON_COLLECTOR_H
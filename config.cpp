@@ -0,0 +1,89 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+// Config Implementation
+std::string Config::DefaultPath() {
+#ifdef _WIN32
+    const char* appdata = getenv("APPDATA");
+    return std::string(appdata ? appdata : ".") + "\\system-monitor.conf";
+#else
+    const char* xdg = getenv("XDG_CONFIG_HOME");
+    if (xdg && *xdg) return std::string(xdg) + "/system-monitor.conf";
+    const char* home = getenv("HOME");
+    if (!home || !*home) {
+        struct passwd* pw = getpwuid(getuid());
+        home = pw ? pw->pw_dir : ".";
+    }
+    return std::string(home) + "/.config/system-monitor.conf";
+#endif
+}
+
+static std::string Trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool Config::Load(const std::string& file) {
+    path = file;
+    values.clear();
+
+    std::ifstream in(file);
+    if (!in.is_open()) return false;
+
+    // Blank lines and lines starting with '#' are ignored
+    std::string line;
+    while (std::getline(in, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) continue;
+        values[Trim(line.substr(0, equals))] = Trim(line.substr(equals + 1));
+    }
+    return true;
+}
+
+bool Config::Save() const {
+    if (path.empty()) return false;
+
+#ifndef _WIN32
+    // Create the directory on first save (~/.config may not exist yet)
+    size_t slash = path.rfind('/');
+    if (slash != std::string::npos && slash > 0) {
+        mkdir(path.substr(0, slash).c_str(), 0755);
+    }
+#endif
+
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << "# System Monitor settings\n";
+        for (const auto& entry : values) {
+            out << entry.first << " = " << entry.second << "\n";
+        }
+        if (!out.good()) return false;
+    }
+
+#ifdef _WIN32
+    remove(path.c_str());
+#endif
+    return rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+std::string Config::Get(const std::string& key, const std::string& fallback) const {
+    auto it = values.find(key);
+    return it != values.end() ? it->second : fallback;
+}
+
+int Config::GetInt(const std::string& key, int fallback) const {
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+    char* end;
+    long value = strtol(it->second.c_str(), &end, 10);
+    return (end != it->second.c_str() && *end == '\0') ? (int)value : fallback;
+}
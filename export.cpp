@@ -0,0 +1,383 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <poll.h>
+#endif
+
+// ExportOptions Implementation
+static const char* EXPORT_GROUP_NAMES[ExportOptions::GROUP_COUNT] = {"system", "cores", "processes", "interfaces"};
+
+const char* ExportOptions::GroupName(int index) {
+    return index >= 0 && index < GROUP_COUNT ? EXPORT_GROUP_NAMES[index] : "";
+}
+
+bool ExportOptions::ParseGroups(const std::string& list) {
+    unsigned parsed = 0;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name.erase(0, name.find_first_not_of(' '));
+        name.erase(name.find_last_not_of(' ') + 1);
+        if (name.empty()) continue;
+        int group = 0;
+        while (group < GROUP_COUNT && name != EXPORT_GROUP_NAMES[group]) group++;
+        if (group == GROUP_COUNT) return false;
+        parsed |= 1u << group;
+    }
+    if (parsed == 0) return false;
+    groups = parsed;
+    return true;
+}
+
+ExportOptions ExportOptions::FromConfig(const Config& config) {
+    ExportOptions options;
+    options.path = config.Get("export.path", "");
+    options.csv = config.Get("export.format", "jsonl") == "csv";
+    std::string groups = config.Get("export.groups", "");
+    if (!groups.empty() && !options.ParseGroups(groups)) {
+        fprintf(stderr, "export: ignoring bad export.groups \"%s\"\n", groups.c_str());
+    }
+    options.rotate_bytes = (uint64_t)std::max(0, config.GetInt("export.rotate_mb", 64)) << 20;
+    options.rotate_keep = std::max(0, config.GetInt("export.rotate_keep", options.rotate_keep));
+    return options;
+}
+
+// One output line. The same calls write a record or, in header mode, the
+// CSV column names, so the two cannot drift apart.
+struct ExportRecord {
+    std::vector<char>& out;
+    bool csv;
+    bool header;
+
+    void Begin(const char* group, double time) {
+        if (header) {
+            out.push_back('#');
+            AppendText(out, group);
+            AppendText(out, ",time");
+        } else if (csv) {
+            AppendText(out, group);
+            out.push_back(',');
+            AppendFixed(out, time, 3);
+        } else {
+            AppendText(out, "{\"time\":");
+            AppendFixed(out, time, 3);
+            AppendText(out, ",\"group\":\"");
+            AppendText(out, group);
+            out.push_back('"');
+        }
+    }
+
+    bool Key(const char* key) {
+        out.push_back(',');
+        if (header) {
+            AppendText(out, key);
+            return false;
+        }
+        if (!csv) {
+            out.push_back('"');
+            AppendText(out, key);
+            AppendText(out, "\":");
+        }
+        return true;
+    }
+
+    template <typename T>
+    void Field(const char* key, T value) {
+        if (Key(key)) AppendNumber(out, value);
+    }
+
+    void Field(const char* key, float value) {
+        if (!Key(key)) return;
+        if (std::isfinite(value)) AppendNumber(out, value);
+        else if (!csv) AppendText(out, "null");
+    }
+
+    void Field(const char* key, const std::string& value) {
+        if (!Key(key)) return;
+        if (csv) {
+            bool quote = value.find_first_of(",\"\n\r") != std::string::npos;
+            if (!quote) {
+                AppendText(out, value);
+                return;
+            }
+            out.push_back('"');
+            for (char c : value) {
+                if (c == '"') out.push_back('"');
+                out.push_back(c);
+            }
+            out.push_back('"');
+            return;
+        }
+        out.push_back('"');
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if ((unsigned char)c < 0x20) {
+                char escape[8];
+                snprintf(escape, sizeof(escape), "\\u%04x", (unsigned char)c);
+                AppendText(out, escape, 6);
+            } else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    void End() {
+        if (!header && !csv) out.push_back('}');
+        out.push_back('\n');
+    }
+};
+
+static void WriteSystemRecord(ExportRecord& record, double time, const SystemInfo& info) {
+    record.Begin("system", time);
+    record.Field("cpu", info.cpu_usage);
+    record.Field("memory_used", info.used_memory);
+    record.Field("memory_total", info.total_memory);
+    record.Field("swap_used", info.used_swap);
+    record.Field("swap_total", info.total_swap);
+    record.Field("disk_used", info.used_disk);
+    record.Field("disk_total", info.total_disk);
+    record.Field("temperature", info.temperature);
+    record.Field("fan_rpm", info.fan_speed);
+    record.Field("processes", info.total_processes);
+    record.Field("running", info.running_processes);
+    record.Field("sleeping", info.sleeping_processes);
+    record.Field("zombie", info.zombie_processes);
+    record.Field("stopped", info.stopped_processes);
+    record.End();
+}
+
+static void WriteCoreRecord(ExportRecord& record, double time, const CPUTimes& cpu, int core) {
+    record.Begin("core", time);
+    record.Field("core", cpu.CoreId(core));
+    record.Field("busy", cpu.busy[core + 1]);
+    for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+        record.Field(CPUTimes::ShareName(s), cpu.percent[s][core + 1]);
+    }
+    record.End();
+}
+
+static void WriteProcessRecord(ExportRecord& record, double time, const ProcessInfo& proc) {
+    record.Begin("process", time);
+    record.Field("pid", proc.pid);
+    record.Field("starttime", proc.starttime);
+    record.Field("name", proc.name);
+    record.Field("state", proc.state);
+    record.Field("cpu", proc.cpu_usage);
+    record.Field("memory", proc.memory_usage);
+    record.End();
+}
+
+static void WriteInterfaceRecord(ExportRecord& record, double time, const NetworkInterface& iface) {
+    record.Begin("interface", time);
+    record.Field("interface", iface.name);
+    record.Field("rx_bytes", iface.rx_bytes);
+    record.Field("tx_bytes", iface.tx_bytes);
+    record.Field("rx_packets", iface.rx_packets);
+    record.Field("tx_packets", iface.tx_packets);
+    record.Field("rx_errs", iface.rx_errs);
+    record.Field("tx_errs", iface.tx_errs);
+    record.Field("rx_drop", iface.rx_drop);
+    record.Field("tx_drop", iface.tx_drop);
+    record.Field("rx_rate", iface.rx_rate);
+    record.Field("tx_rate", iface.tx_rate);
+    record.End();
+}
+
+// SnapshotExporter Implementation
+const size_t SnapshotExporter::FLUSH_BYTES;
+
+void SnapshotExporter::FormatSnapshot(const ExportOptions& options, const MonitorSnapshot& snapshot,
+                                      const bool changed[COLLECTOR_COUNT], std::vector<char>& out) {
+    ExportRecord record{out, options.csv, false};
+    double time = snapshot.time;
+
+    if ((options.groups & ExportOptions::GROUP_SYSTEM) &&
+        (changed[COLLECT_CPU] || changed[COLLECT_THERMAL] || changed[COLLECT_MEMORY] || changed[COLLECT_PROCESSES] ||
+         changed[COLLECT_DISK])) {
+        WriteSystemRecord(record, time, snapshot.system_info);
+    }
+    if ((options.groups & ExportOptions::GROUP_CORES) && changed[COLLECT_CPU] && snapshot.cpu_times.has_previous) {
+        for (int core = 0; core < snapshot.cpu_times.CoreCount(); ++core) {
+            WriteCoreRecord(record, time, snapshot.cpu_times, core);
+        }
+    }
+    if ((options.groups & ExportOptions::GROUP_PROCESSES) && changed[COLLECT_PROCESSES]) {
+        for (const ProcessInfo& proc : snapshot.processes) {
+            if (proc.alive) WriteProcessRecord(record, time, proc);
+        }
+    }
+    if ((options.groups & ExportOptions::GROUP_INTERFACES) && changed[COLLECT_NETWORK]) {
+        for (const NetworkInterface& iface : snapshot.network_interfaces) {
+            WriteInterfaceRecord(record, time, iface);
+        }
+    }
+}
+
+void SnapshotExporter::WriteHeader() {
+    // Each CSV group has its own columns; "#group,time,..." rows name them
+    ExportRecord record{buffer, true, true};
+    CPUTimes cpu;
+    cpu.Resize(2);
+    if (options.groups & ExportOptions::GROUP_SYSTEM) WriteSystemRecord(record, 0, SystemInfo());
+    if (options.groups & ExportOptions::GROUP_CORES) WriteCoreRecord(record, 0, cpu, 0);
+    if (options.groups & ExportOptions::GROUP_PROCESSES) WriteProcessRecord(record, 0, ProcessInfo());
+    if (options.groups & ExportOptions::GROUP_INTERFACES) WriteInterfaceRecord(record, 0, NetworkInterface());
+}
+
+#ifdef _WIN32
+// Only the formatting is available on Windows so far
+bool SnapshotExporter::Start(const ExportOptions& export_options) {
+    (void)export_options;
+    return false;
+}
+
+void SnapshotExporter::Stop() {}
+#else
+bool SnapshotExporter::Start(const ExportOptions& export_options) {
+    Stop();
+    if (export_options.path.empty()) return false;
+    options = export_options;
+    buffer.clear();
+    buffer.reserve(FLUSH_BYTES + (64 << 10));
+    std::fill(exported_versions, exported_versions + COLLECTOR_COUNT, 0);
+    skipped_ticks = 0;
+    running = true;
+    // Opening a named pipe waits for its reader, so that happens on the thread too
+    thread = std::thread(&SnapshotExporter::Run, this);
+    return true;
+}
+
+void SnapshotExporter::Stop() {
+    if (!thread.joinable()) return;
+    running = false;
+    thread.join();
+    if (skipped_ticks > 0) {
+        fprintf(stderr, "export: %llu ticks skipped while the output was behind\n", (unsigned long long)skipped_ticks);
+    }
+}
+
+bool SnapshotExporter::Open() {
+    struct stat info;
+    if (options.path == "-") {
+        fd = dup(STDOUT_FILENO);
+        rotating = false;
+        file_bytes = 0;
+    } else if (stat(options.path.c_str(), &info) == 0 && S_ISFIFO(info.st_mode)) {
+        // Non-blocking, so a stalled reader cannot keep Stop() waiting
+        while (running) {
+            fd = open(options.path.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+            if (fd >= 0 || errno != ENXIO) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        rotating = false;
+        file_bytes = 0;
+    } else {
+        fd = open(options.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        rotating = true;
+        file_bytes = fd >= 0 && fstat(fd, &info) == 0 ? info.st_size : 0;
+    }
+    if (fd < 0) {
+        if (running) fprintf(stderr, "export: cannot open %s: %s\n", options.path.c_str(), strerror(errno));
+        return false;
+    }
+    if (options.csv && file_bytes == 0) WriteHeader();
+    return true;
+}
+
+void SnapshotExporter::Rotate() {
+    close(fd);
+    fd = -1;
+    std::string prefix = options.path + ".";
+    if (options.rotate_keep > 0) {
+        for (int i = options.rotate_keep - 1; i >= 1; --i) {
+            rename((prefix + std::to_string(i)).c_str(), (prefix + std::to_string(i + 1)).c_str());
+        }
+        rename(options.path.c_str(), (prefix + "1").c_str());
+    } else {
+        unlink(options.path.c_str());
+    }
+    Open();
+}
+
+bool SnapshotExporter::Flush() {
+    size_t done = 0;
+    while (done < buffer.size()) {
+        ssize_t written = write(fd, buffer.data() + done, buffer.size() - done);
+        if (written >= 0) {
+            done += written;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN) {
+            // A full pipe; give up only when stopping
+            pollfd wait = {fd, POLLOUT, 0};
+            poll(&wait, 1, 200);
+            if (!running) break;
+            continue;
+        }
+        fprintf(stderr, "export: writing %s failed: %s\n", options.path.c_str(), strerror(errno));
+        buffer.clear();
+        return false;
+    }
+    file_bytes += done;
+    buffer.clear();
+
+    if (rotating && options.rotate_bytes > 0 && file_bytes >= options.rotate_bytes) {
+        Rotate();
+        // The new file's CSV header is in the buffer
+        if (fd < 0) return false;
+    }
+    return true;
+}
+
+void SnapshotExporter::Run() {
+    // A reader closing the pipe should fail the write, not raise SIGPIPE
+    sigset_t pipe_signal;
+    sigemptyset(&pipe_signal);
+    sigaddset(&pipe_signal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_signal, nullptr);
+
+    if (!Open()) {
+        running = false;
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto last_flush = Clock::now();
+    uint64_t sequence = 0;
+    while (running) {
+        collector.WaitForSnapshot(sequence, std::chrono::milliseconds(200));
+        const MonitorSnapshot* snapshot = collector.AcquireSnapshot();
+        if (snapshot && snapshot->sequence != sequence) {
+            if (sequence != 0 && snapshot->sequence > sequence + 1) skipped_ticks += snapshot->sequence - sequence - 1;
+            sequence = snapshot->sequence;
+
+            bool changed[COLLECTOR_COUNT];
+            for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+                changed[c] = snapshot->versions[c] != exported_versions[c];
+                exported_versions[c] = snapshot->versions[c];
+            }
+            FormatSnapshot(options, *snapshot, changed, buffer);
+        }
+        collector.ReleaseSnapshot(snapshot);
+
+        // Large writes, but at least once a second so a pipe reader keeps up
+        auto now = Clock::now();
+        if (buffer.size() >= FLUSH_BYTES || (!buffer.empty() && now - last_flush >= std::chrono::seconds(1))) {
+            if (!Flush()) break;
+            last_flush = now;
+        }
+    }
+
+    if (fd >= 0) {
+        if (!buffer.empty()) Flush();
+        close(fd);
+        fd = -1;
+    }
+    running = false;
+}
+#endif
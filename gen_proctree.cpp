@@ -0,0 +1,256 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// Writes a synthetic procfs/sysfs tree for scale testing: N pids with stat,
+// status, io, comm and cmdline, M interfaces in proc/net/dev and K thermal
+// zones. With --tick the counters keep advancing so CPU and network rates
+// are non-zero. Run the monitor against it with
+//   SYSMON_PROC_ROOT=DIR/proc SYSMON_SYS_ROOT=DIR/sys ./system-monitor
+
+struct TreeShape {
+    std::string dir;
+    int pids = 10000;
+    int interfaces = 16;
+    int thermal_zones = 4;
+    int cores = 8;
+    int tick_ms = 0;            // 0 writes the tree once and exits
+};
+
+static volatile sig_atomic_t g_stop = 0;
+
+static void OnStop(int) {
+    g_stop = 1;
+}
+
+static bool MakeDirs(const std::string& path) {
+    for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1)) {
+        std::string prefix = path.substr(0, slash);
+        if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+            fprintf(stderr, "mkdir %s: %s\n", prefix.c_str(), strerror(errno));
+            return false;
+        }
+        if (slash == std::string::npos) return true;
+    }
+}
+
+// Rewritten in place: collectors keep some of these files open and pread
+// them, so the inode has to stay the same across ticks
+static bool WriteFile(const std::string& path, const char* text, size_t len) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "open %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    bool ok = pwrite(fd, text, len, 0) == (ssize_t)len && ftruncate(fd, len) == 0;
+    close(fd);
+    return ok;
+}
+
+static bool WriteFile(const std::string& path, const std::string& text) {
+    return WriteFile(path, text.data(), text.size());
+}
+
+static const char* PROCESS_NAMES[] = {"bash", "kworker/u16:2-events_unbound", "Web Content", "weird) (name", "cc1plus",
+                                      "postgres", "nginx", "python3", "java", "sshd"};
+
+static const char* ProcessName(int pid) {
+    return PROCESS_NAMES[pid % 10];
+}
+
+// Per-pid counters advance with the tick; every 7th process is busy
+static uint64_t ProcessTicks(int pid, uint64_t tick) {
+    return 1000 + pid % 977 + (pid % 7 == 0 ? tick * 25 : tick / 4);
+}
+
+static bool WritePidStat(const TreeShape& shape, int pid, uint64_t tick) {
+    char path[512], line[512];
+    snprintf(path, sizeof(path), "%s/proc/%d/stat", shape.dir.c_str(), pid);
+    uint64_t utime = ProcessTicks(pid, tick);
+    uint64_t stime = utime / 3;
+    uint64_t rss_pages = 100 + pid % 5000;
+    int len = snprintf(line, sizeof(line),
+        "%d (%s) %c 1 %d %d 0 -1 4194560 2524 32308 69 223 %llu %llu 4799 517 20 0 %d 0 %d %llu %llu "
+        "18446744073709551615 1 1 0 0 0 0 0 4096 1088 0 0 0 %d 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+        pid, ProcessName(pid), pid % 7 == 0 ? 'R' : 'S', pid, pid, (unsigned long long)utime,
+        (unsigned long long)stime, 1 + pid % 6, 1000 + pid, (unsigned long long)(rss_pages * 4096 * 4),
+        (unsigned long long)rss_pages, pid % shape.cores);
+    return WriteFile(path, line, len);
+}
+
+static bool WritePid(const TreeShape& shape, int pid) {
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s/proc/%d", shape.dir.c_str(), pid);
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) return false;
+    std::string base = dir;
+    const char* name = ProcessName(pid);
+    uint64_t rss_kb = (100 + pid % 5000) * 4;
+
+    char text[2048];
+    int len = snprintf(text, sizeof(text),
+        "Name:\t%.15s\nUmask:\t0022\nState:\t%s\nTgid:\t%d\nNgid:\t0\nPid:\t%d\nPPid:\t1\nTracerPid:\t0\n"
+        "Uid:\t1000\t1000\t1000\t1000\nGid:\t1000\t1000\t1000\t1000\nFDSize:\t64\nGroups:\t4 24 27 1000\n"
+        "VmPeak:\t%8llu kB\nVmSize:\t%8llu kB\nVmLck:\t       0 kB\nVmPin:\t       0 kB\nVmHWM:\t%8llu kB\n"
+        "VmRSS:\t%8llu kB\nRssAnon:\t%8llu kB\nRssFile:\t%8llu kB\nRssShmem:\t       0 kB\nVmData:\t%8llu kB\n"
+        "VmStk:\t     132 kB\nVmExe:\t     888 kB\nVmLib:\t    2404 kB\nVmPTE:\t      88 kB\nVmSwap:\t       0 kB\n"
+        "Threads:\t%d\nvoluntary_ctxt_switches:\t%d\nnonvoluntary_ctxt_switches:\t%d\n",
+        name, pid % 7 == 0 ? "R (running)" : "S (sleeping)", pid, pid, (unsigned long long)rss_kb * 5,
+        (unsigned long long)rss_kb * 4, (unsigned long long)rss_kb, (unsigned long long)rss_kb,
+        (unsigned long long)rss_kb * 3 / 4, (unsigned long long)rss_kb / 4, (unsigned long long)rss_kb * 2,
+        1 + pid % 6, 100 + pid % 4000, pid % 300);
+    if (!WriteFile(base + "/status", text, len)) return false;
+
+    len = snprintf(text, sizeof(text),
+        "rchar: %llu\nwchar: %llu\nsyscr: %d\nsyscw: %d\nread_bytes: %llu\nwrite_bytes: %llu\n"
+        "cancelled_write_bytes: 0\n",
+        (unsigned long long)pid * 40961, (unsigned long long)pid * 8193, 100 + pid % 9000, 50 + pid % 4000,
+        (unsigned long long)(pid % 1000) * 4096, (unsigned long long)(pid % 500) * 4096);
+    if (!WriteFile(base + "/io", text, len)) return false;
+
+    if (!WriteFile(base + "/comm", std::string(name).substr(0, 15) + "\n")) return false;
+    std::string cmdline = std::string("/usr/bin/") + name + '\0' + "--synthetic" + '\0';
+    if (!WriteFile(base + "/cmdline", cmdline)) return false;
+    return WritePidStat(shape, pid, 0);
+}
+
+static bool WriteCounters(const TreeShape& shape, uint64_t tick) {
+    std::string proc = shape.dir + "/proc";
+    char line[512];
+
+    // proc/stat: aggregate line then one per core, each core ~30% busy
+    std::string stat;
+    for (int core = -1; core < shape.cores; ++core) {
+        uint64_t scale = core < 0 ? shape.cores : 1;
+        uint64_t user = (20000 + tick * 20) * scale, system = (8000 + tick * 8) * scale;
+        uint64_t idle = (70000 + tick * 70) * scale, iowait = (500 + tick) * scale;
+        if (core < 0) snprintf(line, sizeof(line), "cpu  ");
+        else snprintf(line, sizeof(line), "cpu%d ", core);
+        stat += line;
+        snprintf(line, sizeof(line), "%llu 0 %llu %llu %llu 0 %llu 0 0 0\n", (unsigned long long)user,
+                 (unsigned long long)system, (unsigned long long)idle, (unsigned long long)iowait,
+                 (unsigned long long)(100 + tick) * scale);
+        stat += line;
+    }
+    snprintf(line, sizeof(line), "ctxt %llu\nbtime 1700000000\nprocesses %d\nprocs_running %d\nprocs_blocked 0\n",
+             (unsigned long long)(1000000 + tick * 5000), shape.pids + 1000, shape.pids / 7);
+    stat += line;
+    if (!WriteFile(proc + "/stat", stat)) return false;
+
+    // proc/net/dev: every interface moves ~1 MB/s in and 256 KB/s out at a 1 s tick
+    std::string dev = "Inter-|   Receive                                                |  Transmit\n"
+                      " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed\n";
+    for (int i = 0; i < shape.interfaces; ++i) {
+        uint64_t rx = 1000000ull * (i + 1) + tick * (1 << 20), tx = 500000ull * (i + 1) + tick * (1 << 18);
+        snprintf(line, sizeof(line), "%6s%d: %llu %llu 0 %d 0 0 0 %d %llu %llu 0 0 0 0 0 0\n", "eth", i,
+                 (unsigned long long)rx, (unsigned long long)(rx / 1000), i % 3, i % 5, (unsigned long long)tx,
+                 (unsigned long long)(tx / 800));
+        dev += line;
+    }
+    if (!WriteFile(proc + "/net/dev", dev)) return false;
+
+    // Thermal zones drift between 40 and 80 C
+    for (int zone = 0; zone < shape.thermal_zones; ++zone) {
+        snprintf(line, sizeof(line), "%s/sys/class/thermal/thermal_zone%d/temp", shape.dir.c_str(), zone);
+        std::string path = line;
+        snprintf(line, sizeof(line), "%llu\n", (unsigned long long)(40000 + (zone * 3700 + tick * 500) % 40000));
+        if (!WriteFile(path, line)) return false;
+    }
+    snprintf(line, sizeof(line), "%llu\n", (unsigned long long)(1800 + tick * 10 % 600));
+    return WriteFile(shape.dir + "/sys/class/hwmon/hwmon1/fan1_input", line);
+}
+
+static bool WriteTree(const TreeShape& shape) {
+    std::string proc = shape.dir + "/proc", sys = shape.dir + "/sys";
+    if (!MakeDirs(proc + "/net") || !MakeDirs(sys + "/class/hwmon/hwmon1") || !MakeDirs(sys + "/class/net")) {
+        return false;
+    }
+
+    char text[256];
+    snprintf(text, sizeof(text), "MemTotal:       %llu kB\nMemFree:         4194304 kB\nMemAvailable:    8388608 kB\n"
+             "Buffers:          262144 kB\nCached:          3145728 kB\nSwapTotal:       8388608 kB\n"
+             "SwapFree:        6291456 kB\n", (unsigned long long)16777216 + (uint64_t)shape.pids * 64);
+    if (!WriteFile(proc + "/meminfo", text)) return false;
+    std::string cpuinfo;
+    for (int core = 0; core < shape.cores; ++core) {
+        snprintf(text, sizeof(text), "processor\t: %d\nmodel name\t: Synthetic CPU @ 3.00GHz\ncpu cores\t: %d\n\n", core,
+                 shape.cores);
+        cpuinfo += text;
+    }
+    if (!WriteFile(proc + "/cpuinfo", cpuinfo)) return false;
+
+    for (int i = 0; i < shape.interfaces; ++i) {
+        snprintf(text, sizeof(text), "%s/class/net/eth%d", sys.c_str(), i);
+        if (!MakeDirs(text)) return false;
+        if (!WriteFile(std::string(text) + "/speed", i % 4 == 3 ? "-1\n" : "10000\n")) return false;
+    }
+    for (int zone = 0; zone < shape.thermal_zones; ++zone) {
+        snprintf(text, sizeof(text), "%s/class/thermal/thermal_zone%d", sys.c_str(), zone);
+        if (!MakeDirs(text)) return false;
+        if (!WriteFile(std::string(text) + "/type", zone == 0 ? "x86_pkg_temp\n" : "acpitz\n")) return false;
+    }
+
+    for (int pid = 1; pid <= shape.pids; ++pid) {
+        if (!WritePid(shape, pid)) return false;
+    }
+    return WriteCounters(shape, 0);
+}
+
+static void PrintUsage(const char* program) {
+    printf("Usage: %s DIR [--pids N] [--interfaces M] [--thermal-zones K] [--cores C] [--tick MS]\n"
+           "Writes DIR/proc and DIR/sys (defaults: 10000 pids, 16 interfaces, 4 zones, 8 cores).\n"
+           "  --tick MS  keep advancing CPU, process, network and thermal counters every MS\n"
+           "             milliseconds until interrupted\n"
+           "Then: SYSMON_PROC_ROOT=DIR/proc SYSMON_SYS_ROOT=DIR/sys ./sysmon-agent --once\n", program);
+}
+
+int main(int argc, char** argv) {
+    TreeShape shape;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--pids") == 0 && has_value) shape.pids = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--interfaces") == 0 && has_value) shape.interfaces = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--thermal-zones") == 0 && has_value) shape.thermal_zones = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cores") == 0 && has_value) shape.cores = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--tick") == 0 && has_value) shape.tick_ms = atoi(argv[++i]);
+        else if (argv[i][0] != '-' && shape.dir.empty()) shape.dir = argv[i];
+        else {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (shape.dir.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!WriteTree(shape)) return 1;
+    printf("wrote %d pids, %d interfaces, %d thermal zones under %s in %.1f s\n", shape.pids, shape.interfaces,
+           shape.thermal_zones, shape.dir.c_str(),
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    if (shape.tick_ms <= 0) return 0;
+
+    signal(SIGINT, OnStop);
+    signal(SIGTERM, OnStop);
+    auto next = std::chrono::steady_clock::now();
+    for (uint64_t tick = 1; !g_stop; ++tick) {
+        next += std::chrono::milliseconds(shape.tick_ms);
+        if (!WriteCounters(shape, tick)) return 1;
+        for (int pid = 1; pid <= shape.pids && !g_stop; ++pid) {
+            if (!WritePidStat(shape, pid, tick)) return 1;
+        }
+        std::this_thread::sleep_until(next);
+    }
+    return 0;
+}
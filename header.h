@@ -6,218 +6,132 @@
 #include <imgui_impl_sdl.h>
 #include <imgui_impl_opengl3.h>
 #include <GL/gl3w.h>
-#include <vector>
-#include <string>
-#include <map>
-#include <thread>
-#include <chrono>
-#include <fstream>
-#include <sstream>
-#include <algorithm>
-#include <numeric>
-#include <cmath>
-#include <mutex>
-
-#ifdef _WIN32
-#include <windows.h>
-#include <psapi.h>
-#include <pdh.h>
-#include <iphlpapi.h>
-#pragma comment(lib, "pdh.lib")
-#pragma comment(lib, "iphlpapi.lib")
-#else
-#include <unistd.h>
-#include <sys/utsname.h>
-#include <sys/sysinfo.h>
-#include <dirent.h>
-#include <pwd.h>
-#include <ifaddrs.h>
-#include <net/if.h>
-#include <arpa/inet.h>
-#include <sys/statvfs.h>
-#include <signal.h>
-#include <unistd.h>
-#endif
-
-// Data structures
-struct ProcessInfo {
-    int pid;
-    std::string name;
-    std::string state;
-    float cpu_usage;
-    float memory_usage;
-};
-
-struct NetworkInterface {
-    std::string name;
-    std::string description;
-    std::string ipv4;
-    int type;
-    std::string ipv6;
-    bool operational_status;
-    std::string mac_address;
-    uint32_t speed_mbps;
-    uint64_t rx_rate, rx_bytes, rx_packets, rx_errs, rx_drop, rx_fifo, rx_frame, rx_compressed, rx_multicast;
-    uint64_t tx_rate, tx_bytes, tx_packets, tx_errs, tx_drop, tx_fifo, tx_colls, tx_carrier, tx_compressed;
-    uint64_t rx_packet_rate, tx_packet_rate;
-};
-
-struct SystemInfo {
-    std::string os_type;
-    std::string username;
-    std::string hostname;
-    int total_processes = 0;
-    int running_processes = 0;
-    int sleeping_processes = 0;
-    int zombie_processes = 0;
-    int stopped_processes = 0;
-    std::string cpu_type;
-    float cpu_usage = 0.0f;
-    float memory_usage = 0.0f;
-    float swap_usage = 0.0f;
-    float disk_usage = 0.0f;
-    float temperature = 0.0f;
-    int fan_speed = 0;
-    bool fan_active = false;
-    uint64_t total_memory = 0;
-    uint64_t used_memory = 0;
-    uint64_t total_swap = 0;
-    uint64_t used_swap = 0;
-    uint64_t total_disk = 0;
-    uint64_t used_disk = 0;
-};
-
-// Forward declarations
-class SystemMonitor;
-class SystemManager;
-class MemoryManager;
-class NetworkManager;
-
-// System Manager Class
-class SystemManager {
-private:
-    SystemInfo system_info;
-    std::vector<float> cpu_history;
-    std::vector<float> fan_history;
-    std::vector<float> temp_history;
-    static const int HISTORY_SIZE = 200;
+#include <set>
+#include "collector.h"
 
+// Rendering of the collectors' snapshots (system_ui.cpp, mem_ui.cpp,
+// network_ui.cpp, overhead_ui.cpp). Views read only the snapshot and keep UI-only state.
+class SystemView {
 public:
-    SystemManager();
-    void Initialize();
-    void Update();
-    void UpdateCPUUsage();
-    void UpdateThermalInfo();
-    
-    // Getters
-    const SystemInfo& GetSystemInfo() const { return system_info; }
-    const std::vector<float>& GetCPUHistory() const { return cpu_history; }
-    const std::vector<float>& GetFanHistory() const { return fan_history; }
-    const std::vector<float>& GetTempHistory() const { return temp_history; }
-    
-    // Rendering
-    void RenderSystemInfo();
-    void RenderCPUTab();
-    void RenderFanTab();
-    void RenderThermalTab();
+    void RenderSystemInfo(const MonitorSnapshot& snapshot);
+    void RenderCPUTab(const MonitorSnapshot& snapshot);
+    void RenderCoreGrid(const MonitorSnapshot& snapshot);
+    void RenderCPUBreakdownGraph(const MonitorSnapshot& snapshot);
+    void RenderFanTab(const MonitorSnapshot& snapshot);
+    void RenderThermalTab(const MonitorSnapshot& snapshot);
     void RenderGraphControls();
-
-private:
-#ifdef _WIN32
-    void InitializeWindows();
-    void UpdateWindows();
-#else
-    void InitializeLinux();
-    void UpdateLinux();
-#endif
 };
 
-// Memory Manager Class
-class MemoryManager {
+class MemoryView {
 private:
-    std::vector<ProcessInfo> processes;
-    std::vector<bool> selected_processes;
+    MemoryManager& manager;     // Settings only; they are atomics applied by the collector
+    std::set<std::pair<int, uint64_t>> selected_processes;    // (pid, starttime) of each selected process
+    std::vector<uint32_t> display_order;    // Live rows in table display order
+    std::vector<uint8_t> row_listed;        // Scratch for RefreshDisplayOrder
+    std::vector<uint32_t> sort_kept;        // Scratch for the re-sort
+    std::vector<uint32_t> sort_moved;
+    uint64_t sorted_version = ~0ull;        // Process collector version the order was sorted for
+    std::vector<uint32_t> filtered_rows;    // The display order less rows the filter hides
+    uint32_t display_version = 0;
+    uint32_t order_version = 0;             // Bumped whenever display_order changes
+    uint32_t filtered_order_version = ~0u;  // order_version that filtered_rows follows
+    uint32_t filtered_membership = ~0u;     // display_version the matches were computed for
     char process_filter[256] = "";
-    SystemInfo* system_info_ref;
-
-public:
-    MemoryManager(SystemInfo* sys_info);
-    void Update();
-    void UpdateMemoryInfo();
-    void UpdateProcesses();
-    void UpdateDiskInfo();
-    void KillSelectedProcesses();
     
-    // Getters
-    const std::vector<ProcessInfo>& GetProcesses() const { return processes; }
+    // Per row: the lowercased name and the pid, separated by a character the
+    // filter box cannot hold, so one search covers both. Refreshed only when
+    // the process collector has run; matches is against applied_filter.
+    struct SearchEntry {
+        int pid = 0;
+        std::string name;   // As last seen; exec can rename a process in place
+        std::string text;
+        bool matches = true;
+    };
+    std::vector<SearchEntry> search_cache;
+    uint64_t search_version = ~0ull;        // Process collector version of the cache
+    std::string filter_lower;
+    std::string applied_filter;
     
-    // Rendering
-    void RenderMemoryAndProcesses();
+    bool RefreshSearchCache(const MonitorSnapshot& snapshot);   // True when a row's text changed
+
+public:
+    explicit MemoryView(MemoryManager& memory_manager) : manager(memory_manager) {}
+    void RenderMemoryAndProcesses(const MonitorSnapshot& snapshot);
+    void RenderProcessExits(const MonitorSnapshot& snapshot);
+    void KillSelectedProcesses(const MonitorSnapshot& snapshot);
     
-    // Utility
-    std::string FormatBytes(uint64_t bytes);
+    // Process table; the display order holds row indices, the rows never move
+    bool RefreshDisplayOrder(const MonitorSnapshot& snapshot);   // True when rebuilt
+    // nearly_sorted re-sorts the current order in about linear time when few rows have moved
+    void SortDisplayOrder(const std::vector<ProcessInfo>& rows, const ImGuiTableSortSpecs* sort_specs,
+                          bool nearly_sorted = false);
+    const std::vector<uint32_t>& GetDisplayOrder() const { return display_order; }
+    // The rows to draw, in display order; filter must already be lowercase.
+    // Rebuilt only when the filter, the rows or their order change.
+    const std::vector<uint32_t>& FilterDisplayOrder(const MonitorSnapshot& snapshot, const std::string& filter);
 };
 
-// Network Manager Class
-class NetworkManager {
-private:
-    std::vector<NetworkInterface> network_interfaces;
-    std::vector<NetworkInterface> previous_interfaces;
-    std::chrono::steady_clock::time_point previous_update_time;
-
+class NetworkView {
 public:
-    NetworkManager();
-    void Update();
-    // void UpdateNetworkInfo();
-    void UpdateNetworkInterfaces();
-    void CalculateNetworkRates();
+    void RenderNetwork(const MonitorSnapshot& snapshot);
+    void RenderNetworkTable(const MonitorSnapshot& snapshot, bool is_rx);
+    void RenderNetworkInfo(const MonitorSnapshot& snapshot);
+    void RenderNetworkStatistics(const MonitorSnapshot& snapshot);
+};
 
-    #ifdef _WIN32
-    void UpdateNetworkInterfacesWindows();
-    #else
-    void UpdateNetworkInterfacesLinux();
-    void GetInterfaceDetails(NetworkInterface&);
-    #endif
+// The monitor's own cost: collector and render latencies, CPU and memory
+class OverheadView {
+private:
+    double reset_time = WallSeconds();    // Start of the busy-time average
+    // Histograms as of the last reset. The shared ones keep counting, since
+    // the metrics endpoint exports them as monotonic sums.
+    std::vector<LatencyHistogram::Counts> baselines;
+    LatencyHistogram::Counts window;      // One row since the reset
 
-    
-    // Getters
-    const std::vector<NetworkInterface>& GetNetworkInterfaces() const { return network_interfaces; }
-    
-    // Rendering
-    void RenderNetwork();
-    void RenderNetworkTable(bool is_rx);
-    void RenderNetworkInfo();
-    void RenderNetworkStatistics();
+    void LatencyRow(const char* name, int row);
+
+public:
+    void RenderOverhead(const MonitorSnapshot& snapshot);
+    void Reset();
     
     // Utility
-    std::string FormatRate(uint64_t bytes_per_sec);
-    std::string FormatBytes(uint64_t bytes);
+    static std::string FormatDuration(uint64_t ns);
+};
+
+// Parts of a frame timed into SystemMonitor's render histograms
+enum RenderPhase {
+    RENDER_FRAME,
+    RENDER_SYSTEM_TAB,
+    RENDER_GRAPHS,
+    RENDER_PROCESS_TABLE,
+    RENDER_NETWORK_TAB,
+    RENDER_PHASE_COUNT
 };
 
 // Main System Monitor Class
 class SystemMonitor {
 private:
-    SystemManager system_manager;
-    MemoryManager memory_manager;
-    NetworkManager network_manager;
-    std::mutex data_mutex;
+    Collector collector;
+    SystemView system_view;
+    MemoryView memory_view;
+    NetworkView network_view;
+    OverheadView overhead_view;
+    LatencyHistogram render_latency[RENDER_PHASE_COUNT];
     
     // UI State
     bool animate_graphs = true;
     float graph_fps = 30.0f;
     float graph_y_scale = 100.0f;
+    int graph_window = 0;               // Index into GRAPH_WINDOWS
+    double graph_end_time = 0.0;        // Right edge of the graphs; frozen while paused
     int selected_tab = 0;
 
 public:
     SystemMonitor();
-    void Update();
+    Collector& GetCollector() { return collector; }
+    // Render thread: draws the latest snapshot without locking
     void RenderSystemMonitor();
-    
-    // Getters for managers
-    SystemManager& GetSystemManager() { return system_manager; }
-    MemoryManager& GetMemoryManager() { return memory_manager; }
-    NetworkManager& GetNetworkManager() { return network_manager; }
-    std::mutex& GetDataMutex() { return data_mutex; }
+    void RenderSettings();
     
     // UI State getters/setters
     bool GetAnimateGraphs() const { return animate_graphs; }
@@ -226,6 +140,15 @@ public:
     void SetGraphFPS(float fps) { graph_fps = fps; }
     float GetGraphYScale() const { return graph_y_scale; }
     void SetGraphYScale(float scale) { graph_y_scale = scale; }
+    int GetGraphWindow() const { return graph_window; }
+    void SetGraphWindow(int window) { graph_window = window; }
+    double GetGraphEndTime() const { return graph_end_time; }
+    LatencyHistogram& GetRenderLatency(int phase) { return render_latency[phase]; }
+    static const char* RenderPhaseName(int phase);
+    
+    static const int GRAPH_WINDOW_COUNT = 6;
+    static const char* GraphWindowName(int window);
+    static double GraphWindowSeconds(int window);
 };
 
 // Global variables
@@ -0,0 +1,586 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+double WallSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// TieredHistory Implementation
+// Raw keeps 10 minutes at the default 250 ms CPU interval; the rollups keep
+// 6 hours, 1 day and 1 week
+const double TieredHistory::TIER_SECONDS[TIER_COUNT] = {0.0, 10.0, 60.0, 600.0};
+const size_t TieredHistory::TIER_CAPACITY[TIER_COUNT] = {2400, 2160, 1440, 1008};
+
+TieredHistory::TieredHistory() {
+    for (int t = 0; t < TIER_COUNT; ++t) {
+        tiers[t].Reset(TIER_CAPACITY[t]);
+    }
+}
+
+void TieredHistory::Roll(int first_tier, const HistoryBucket& input, HistoryBucket* completed) {
+    for (int t = first_tier; t < TIER_COUNT; ++t) {
+        // Buckets are aligned to multiples of their width
+        double start = std::floor(input.time / TIER_SECONDS[t]) * TIER_SECONDS[t];
+        HistoryBucket& bucket = open[t];
+        if (bucket.count > 0 && bucket.time != start) {
+            tiers[t].Push(bucket);
+            if (t == TIER_10S && completed) *completed = bucket;
+            bucket = HistoryBucket();
+        }
+        if (bucket.count == 0) bucket.time = start;
+        bucket.Merge(input);
+    }
+}
+
+bool TieredHistory::Add(double time, float value, HistoryBucket* completed) {
+    HistoryBucket sample;
+    sample.time = time;
+    sample.Add(value);
+    tiers[TIER_RAW].Push(sample);
+
+    uint64_t closed = tiers[TIER_10S].Head();
+    Roll(TIER_10S, sample, completed);
+    return tiers[TIER_10S].Head() != closed;
+}
+
+void TieredHistory::Restore(const HistoryBucket& bucket) {
+    tiers[TIER_10S].Push(bucket);
+    Roll(TIER_1M, bucket, nullptr);
+}
+
+TieredHistory::View TieredHistory::GetView() const {
+    View view;
+    for (int t = 0; t < TIER_COUNT; ++t) {
+        view.tiers[t] = tiers[t].Spans();
+        view.open[t] = open[t];
+    }
+    return view;
+}
+
+int TieredHistory::View::PickTier(double window_seconds, size_t max_points) const {
+    // Raw when it reaches back far enough (or nothing older exists) and is not too dense
+    const RingSpans<HistoryBucket>& raw = tiers[TIER_RAW];
+    if (!raw.empty()) {
+        size_t first = raw.size() > max_points ? raw.size() - max_points : 0;
+        const RingSpans<HistoryBucket>& rollup = tiers[TIER_10S];
+        bool older = !rollup.empty() && rollup[0].time + TIER_SECONDS[TIER_10S] < raw[first].time;
+        if (raw.back().time - raw[first].time >= window_seconds || (first == 0 && !older)) {
+            return TIER_RAW;
+        }
+    }
+
+    for (int t = TIER_10S; t < TIER_COUNT; ++t) {
+        if (window_seconds / TIER_SECONDS[t] <= (double)max_points) return t;
+    }
+    return TIER_10M;
+}
+
+// HistoryStore Implementation
+const int HistoryStore::RETENTION_DAYS;
+const size_t HistoryStore::HEADER_SIZE;
+const uint32_t HistoryStore::SEGMENT_CAPACITY;
+
+static const char HISTORY_MAGIC[8] = {'S', 'M', 'H', 'I', 'S', 'T', '1', '\0'};
+static const uint32_t HISTORY_VERSION = 2;
+static const char SEALED_MAGIC[8] = {'S', 'M', 'S', 'E', 'A', 'L', '1', '\0'};
+
+// A sealed day: this header, one SealedMetric per metric, then each metric's
+// blocks back to back in the same order. Times are in milliseconds.
+struct SealedHeader {
+    char magic[8];
+    uint32_t metric_count;
+    uint32_t reserved;
+};
+
+struct SealedMetric {
+    enum Block { BLOCK_MIN, BLOCK_MAX, BLOCK_AVERAGE, BLOCK_COUNT, BLOCK_TOTAL };
+    char name[HistorySegmentHeader::NAME_SIZE];
+    uint32_t points;
+    uint32_t sizes[BLOCK_TOTAL];        // Float blocks, then the count as a counter block
+};
+
+uint32_t HistoryRecord::Checksum() const {
+    // FNV-1a over the fields; an all-zero (never written) slot does not match
+    const unsigned char* bytes = (const unsigned char*)this;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(HistoryRecord, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int64_t DayOf(double time) {
+    return (int64_t)std::floor(time / 86400.0);
+}
+
+std::string HistoryStore::DefaultDirectory() {
+#ifdef _WIN32
+    const char* appdata = getenv("APPDATA");
+    return std::string(appdata ? appdata : ".") + "\\system-monitor\\history";
+#else
+    const char* xdg = getenv("XDG_DATA_HOME");
+    if (xdg && *xdg) return std::string(xdg) + "/system-monitor/history";
+    const char* home = getenv("HOME");
+    if (!home || !*home) {
+        struct passwd* pw = getpwuid(getuid());
+        home = pw ? pw->pw_dir : ".";
+    }
+    return std::string(home) + "/.local/share/system-monitor/history";
+#endif
+}
+
+std::string HistoryStore::SegmentPath(int64_t day, const char* extension) const {
+    time_t seconds = (time_t)(day * 86400);
+    struct tm date;
+#ifdef _WIN32
+    gmtime_s(&date, &seconds);
+#else
+    gmtime_r(&seconds, &date);
+#endif
+    char name[32];
+    strftime(name, sizeof(name), "%Y-%m-%d", &date);
+    return directory + "/" + name + extension;
+}
+
+#ifdef _WIN32
+// No mmap backend on Windows yet; history is kept in memory only
+bool HistoryStore::Open(const std::string& dir, const std::vector<std::string>& metrics) {
+    (void)dir;
+    (void)metrics;
+    return false;
+}
+
+void HistoryStore::Close() {}
+
+size_t HistoryStore::Load(double since, const std::function<void(int, const HistoryBucket&)>& restore) {
+    (void)since;
+    (void)restore;
+    return 0;
+}
+
+bool HistoryStore::Append(int metric, const HistoryBucket& bucket) {
+    (void)metric;
+    (void)bucket;
+    return false;
+}
+
+int HistoryStore::AddMetric(const std::string& name) {
+    (void)name;
+    return -1;
+}
+#else
+bool HistoryStore::Open(const std::string& dir, const std::vector<std::string>& metrics) {
+    Close();
+    if (dir.empty() || metrics.size() > (size_t)HistorySegmentHeader::MAX_METRICS) return false;
+
+    // mkdir -p
+    for (size_t slash = dir.find('/', 1); ; slash = dir.find('/', slash + 1)) {
+        std::string parent = dir.substr(0, slash);
+        if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        if (slash == std::string::npos) break;
+    }
+
+    directory = dir;
+    metric_names = metrics;
+    PruneSegments(DayOf(WallSeconds()));
+    return true;
+}
+
+void HistoryStore::Close() {
+    UnmapSegment(segment);
+    directory.clear();
+    full_reported = false;
+    busy_reported = false;
+}
+
+bool HistoryStore::MapSegment(Segment& target, int64_t day, bool writable) {
+    std::string path = SegmentPath(day);
+    int fd = open(path.c_str(), writable ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC), 0644);
+    if (fd < 0) return false;
+
+    // One writer per segment: the GUI and the agent share the default directory,
+    // and each would append at its own record count. Released when fd closes.
+    if (writable && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        if (!busy_reported) {
+            fprintf(stderr, "History segment %s is in use by another process; not appending to it\n", path.c_str());
+            busy_reported = true;
+        }
+        close(fd);
+        return false;
+    }
+
+    size_t size = HEADER_SIZE + (size_t)SEGMENT_CAPACITY * sizeof(HistoryRecord);
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    bool created = info.st_size == 0;
+    if (created && writable) {
+        // Sparse: disk is only used as records are written
+        if (ftruncate(fd, size) != 0) {
+            close(fd);
+            return false;
+        }
+    } else if ((size_t)info.st_size < HEADER_SIZE) {
+        close(fd);
+        return false;
+    } else {
+        size = std::min(size, (size_t)info.st_size);
+    }
+
+    void* map = mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    target.fd = fd;
+    target.map = (char*)map;
+    target.map_size = size;
+    target.day = day;
+    target.count = 0;
+
+    HistorySegmentHeader* header = target.Header();
+    if (created && writable) {
+        memcpy(header->magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+        header->version = HISTORY_VERSION;
+        header->record_size = sizeof(HistoryRecord);
+        header->capacity = SEGMENT_CAPACITY;
+        header->metric_count = 0;
+        header->day = day;
+        std::fill(header->hour_first, header->hour_first + 24, HistorySegmentHeader::NO_RECORD);
+    } else if (memcmp(header->magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0 ||
+               (header->version != HISTORY_VERSION && header->version != 1) ||
+               header->record_size != sizeof(HistoryRecord) ||
+               header->metric_count > (uint32_t)(header->version == 1 ? HistorySegmentHeader::V1_MAX_METRICS
+                                                                       : HistorySegmentHeader::MAX_METRICS)) {
+        UnmapSegment(target);
+        return false;
+    } else if (header->version == 1 && writable) {
+        // Widen the name table; from the last name down, so no name is
+        // overwritten before it has moved
+        char* names = (char*)header->metric_names;
+        for (int slot = (int)header->metric_count - 1; slot >= 0; --slot) {
+            memmove(names + slot * HistorySegmentHeader::NAME_SIZE, names + slot * HistorySegmentHeader::V1_NAME_SIZE,
+                    HistorySegmentHeader::V1_NAME_SIZE);
+            memset(names + slot * HistorySegmentHeader::NAME_SIZE + HistorySegmentHeader::V1_NAME_SIZE, 0,
+                   HistorySegmentHeader::NAME_SIZE - HistorySegmentHeader::V1_NAME_SIZE);
+        }
+        header->version = HISTORY_VERSION;
+    }
+
+    // Valid records run up to the first bad checksum; anything after a torn record is dropped
+    uint32_t capacity = (uint32_t)std::min<size_t>(header->capacity, (size - HEADER_SIZE) / sizeof(HistoryRecord));
+    HistoryRecord* records = target.Records();
+    while (target.count < capacity && records[target.count].IsValid()) {
+        target.count++;
+    }
+    if (writable && target.count < capacity) {
+        records[target.count] = HistoryRecord();
+    }
+
+    // Map the metrics we write to the segment's name table, adding new names
+    for (size_t m = 0; m < metric_names.size(); ++m) {
+        MapMetric(target, m, writable);
+    }
+    return true;
+}
+
+void HistoryStore::MapMetric(Segment& target, size_t m, bool writable) {
+    HistorySegmentHeader* header = target.Header();
+    // A version 1 header is only left unwidened when mapped read-only
+    int stride = header->version == 1 ? HistorySegmentHeader::V1_NAME_SIZE : HistorySegmentHeader::NAME_SIZE;
+    const char* names = (const char*)header->metric_names;
+    target.slots[m] = -1;
+    for (uint32_t slot = 0; slot < header->metric_count; ++slot) {
+        if (strncmp(names + slot * stride, metric_names[m].c_str(), stride) == 0) {
+            target.slots[m] = (int)slot;
+        }
+    }
+    if (target.slots[m] < 0 && writable && header->metric_count < (uint32_t)HistorySegmentHeader::MAX_METRICS) {
+        char* name = header->metric_names[header->metric_count];
+        memset(name, 0, HistorySegmentHeader::NAME_SIZE);
+        strncpy(name, metric_names[m].c_str(), HistorySegmentHeader::NAME_SIZE - 1);
+        target.slots[m] = (int)header->metric_count++;
+    }
+}
+
+void HistoryStore::UnmapSegment(Segment& target) {
+    if (target.map) munmap(target.map, target.map_size);
+    if (target.fd >= 0) close(target.fd);
+    target = Segment();
+}
+
+void HistoryStore::PruneSegments(int64_t today) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return;
+    std::vector<int64_t> unsealed;
+    while (struct dirent* entry = readdir(dir)) {
+        struct tm date = {};
+        int length = 0;
+        if (sscanf(entry->d_name, "%4d-%2d-%2d%n", &date.tm_year, &date.tm_mon, &date.tm_mday, &length) != 3) continue;
+        date.tm_year -= 1900;
+        date.tm_mon -= 1;
+        int64_t day = (int64_t)timegm(&date) / 86400;
+        if (today - day >= RETENTION_DAYS) {
+            unlink((directory + "/" + entry->d_name).c_str());
+        } else if (day < today && strcmp(entry->d_name + length, ".hist") == 0) {
+            unsealed.push_back(day);
+        }
+    }
+    closedir(dir);
+
+    for (int64_t day : unsealed) {
+        SealSegment(day);
+    }
+}
+
+void HistoryStore::SealSegment(int64_t day) {
+    // Holding the lock keeps a writer still on that day from appending meanwhile
+    std::string path = SegmentPath(day);
+    int lock = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (lock < 0) return;
+    if (flock(lock, LOCK_EX | LOCK_NB) != 0) {
+        close(lock);
+        return;
+    }
+    Segment stored;
+    if (!MapSegment(stored, day, false)) {
+        close(lock);
+        return;
+    }
+
+    // Split the records by metric, keeping each metric's order
+    const HistorySegmentHeader* header = stored.Header();
+    struct Series {
+        std::vector<int64_t> times;
+        std::vector<float> values[SealedMetric::BLOCK_COUNT];
+        std::vector<uint64_t> counts;
+    };
+    std::vector<Series> series(header->metric_count);
+    const HistoryRecord* records = stored.Records();
+    for (uint32_t i = 0; i < stored.count; ++i) {
+        const HistoryRecord& record = records[i];
+        if (record.metric >= header->metric_count) continue;
+        Series& target = series[record.metric];
+        target.times.push_back((int64_t)std::llround(record.time * 1000.0));
+        target.values[SealedMetric::BLOCK_MIN].push_back(record.min);
+        target.values[SealedMetric::BLOCK_MAX].push_back(record.max);
+        target.values[SealedMetric::BLOCK_AVERAGE].push_back(record.average);
+        target.counts.push_back(record.count);
+    }
+
+    SealedHeader sealed = {};
+    memcpy(sealed.magic, SEALED_MAGIC, sizeof(SEALED_MAGIC));
+    sealed.metric_count = header->metric_count;
+    std::vector<SealedMetric> metrics(header->metric_count);
+    std::vector<uint8_t> blocks;
+    int stride = header->version == 1 ? HistorySegmentHeader::V1_NAME_SIZE : HistorySegmentHeader::NAME_SIZE;
+    for (uint32_t slot = 0; slot < header->metric_count; ++slot) {
+        SealedMetric& metric = metrics[slot];
+        memset(&metric, 0, sizeof(metric));
+        strncpy(metric.name, (const char*)header->metric_names + slot * stride, std::min(stride, HistorySegmentHeader::NAME_SIZE - 1));
+        const Series& source = series[slot];
+        metric.points = (uint32_t)source.times.size();
+        if (metric.points == 0) continue;
+        for (int b = 0; b < SealedMetric::BLOCK_TOTAL; ++b) {
+            size_t before = blocks.size();
+            if (b == SealedMetric::BLOCK_COUNT) {
+                EncodeCounterBlock(source.times.data(), source.counts.data(), metric.points, blocks);
+            } else {
+                EncodeFloatBlock(source.times.data(), source.values[b].data(), metric.points, blocks);
+            }
+            metric.sizes[b] = (uint32_t)(blocks.size() - before);
+        }
+    }
+    UnmapSegment(stored);
+
+    // Written aside and renamed, so a reader sees either the segment or the whole sealed file
+    std::string sealed_path = SegmentPath(day, ".hsz");
+    std::string temp_path = sealed_path + ".tmp";
+    FILE* out = fopen(temp_path.c_str(), "wb");
+    bool written = out &&
+        fwrite(&sealed, sizeof(sealed), 1, out) == 1 &&
+        (metrics.empty() || fwrite(metrics.data(), sizeof(SealedMetric), metrics.size(), out) == metrics.size()) &&
+        (blocks.empty() || fwrite(blocks.data(), 1, blocks.size(), out) == blocks.size());
+    if (out && fflush(out) != 0) written = false;
+    if (out && fsync(fileno(out)) != 0) written = false;
+    if (out && fclose(out) != 0) written = false;
+    if (written && rename(temp_path.c_str(), sealed_path.c_str()) == 0) {
+        unlink(path.c_str());
+    } else {
+        unlink(temp_path.c_str());
+    }
+    close(lock);
+}
+
+size_t HistoryStore::LoadSealed(int64_t day, double since, const std::function<void(int, const HistoryBucket&)>& restore) {
+    std::ifstream in(SegmentPath(day, ".hsz"), std::ios::binary);
+    if (!in) return 0;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    SealedHeader sealed;
+    if (data.size() < sizeof(sealed)) return 0;
+    memcpy(&sealed, data.data(), sizeof(sealed));
+    if (memcmp(sealed.magic, SEALED_MAGIC, sizeof(SEALED_MAGIC)) != 0 ||
+        sealed.metric_count > (uint32_t)HistorySegmentHeader::MAX_METRICS ||
+        data.size() < sizeof(sealed) + sealed.metric_count * sizeof(SealedMetric)) {
+        return 0;
+    }
+
+    size_t loaded = 0;
+    size_t offset = sizeof(sealed) + sealed.metric_count * sizeof(SealedMetric);
+    std::vector<int64_t> times;
+    std::vector<float> values[SealedMetric::BLOCK_COUNT];
+    std::vector<uint64_t> counts;
+    for (uint32_t slot = 0; slot < sealed.metric_count; ++slot) {
+        SealedMetric metric;
+        memcpy(&metric, data.data() + sizeof(sealed) + slot * sizeof(SealedMetric), sizeof(metric));
+        size_t size = 0;
+        for (int b = 0; b < SealedMetric::BLOCK_TOTAL; ++b) size += metric.sizes[b];
+        if (offset + size > data.size()) break;
+        size_t start = offset;
+        offset += size;
+
+        int id = -1;
+        for (size_t m = 0; m < metric_names.size(); ++m) {
+            if (strncmp(metric.name, metric_names[m].c_str(), HistorySegmentHeader::NAME_SIZE) == 0) id = (int)m;
+        }
+        if (id < 0 || metric.points == 0) continue;
+
+        // Each block repeats the timestamps; a corrupt block drops just its metric
+        times.resize(metric.points);
+        counts.resize(metric.points);
+        bool valid = true;
+        for (int b = 0; b < SealedMetric::BLOCK_TOTAL && valid; ++b) {
+            if (b == SealedMetric::BLOCK_COUNT) {
+                valid = DecodeCounterBlock(data.data() + start, metric.sizes[b], metric.points, times.data(), counts.data());
+            } else {
+                values[b].resize(metric.points);
+                valid = DecodeFloatBlock(data.data() + start, metric.sizes[b], metric.points, times.data(), values[b].data());
+            }
+            start += metric.sizes[b];
+        }
+        if (!valid) continue;
+
+        for (uint32_t i = 0; i < metric.points; ++i) {
+            HistoryBucket bucket;
+            bucket.time = times[i] / 1000.0;
+            if (bucket.time < since || counts[i] == 0) continue;
+            bucket.min = values[SealedMetric::BLOCK_MIN][i];
+            bucket.max = values[SealedMetric::BLOCK_MAX][i];
+            bucket.count = (uint32_t)counts[i];
+            bucket.sum = (double)values[SealedMetric::BLOCK_AVERAGE][i] * bucket.count;
+            restore(id, bucket);
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+size_t HistoryStore::Load(double since, const std::function<void(int, const HistoryBucket&)>& restore) {
+    if (!IsOpen()) return 0;
+
+    size_t loaded = 0;
+    int64_t today = DayOf(WallSeconds());
+    for (int64_t day = std::max(DayOf(since), today - RETENTION_DAYS + 1); day <= today; ++day) {
+        Segment stored;
+        if (!MapSegment(stored, day, false)) {
+            loaded += LoadSealed(day, since, restore);
+            continue;
+        }
+        const HistorySegmentHeader* header = stored.Header();
+
+        // Header slot back to our metric id
+        int metric_of_slot[HistorySegmentHeader::MAX_METRICS];
+        std::fill(metric_of_slot, metric_of_slot + HistorySegmentHeader::MAX_METRICS, -1);
+        for (size_t m = 0; m < metric_names.size(); ++m) {
+            if (stored.slots[m] >= 0) metric_of_slot[stored.slots[m]] = (int)m;
+        }
+
+        // The hour index skips straight to the first hour we need
+        uint32_t first = 0;
+        if (day == DayOf(since)) {
+            int hour = (int)((since - day * 86400.0) / 3600.0);
+            first = stored.count;
+            for (int h = std::max(0, hour); h < 24; ++h) {
+                if (header->hour_first[h] != HistorySegmentHeader::NO_RECORD) {
+                    first = std::min(header->hour_first[h], stored.count);
+                    break;
+                }
+            }
+        }
+
+        const HistoryRecord* records = stored.Records();
+        for (uint32_t i = first; i < stored.count; ++i) {
+            const HistoryRecord& record = records[i];
+            if (record.time < since || record.metric >= HistorySegmentHeader::MAX_METRICS) continue;
+            int metric = metric_of_slot[record.metric];
+            if (metric < 0) continue;
+
+            HistoryBucket bucket;
+            bucket.time = record.time;
+            bucket.min = record.min;
+            bucket.max = record.max;
+            bucket.count = record.count;
+            bucket.sum = (double)record.average * record.count;
+            restore(metric, bucket);
+            loaded++;
+        }
+        UnmapSegment(stored);
+    }
+    return loaded;
+}
+
+bool HistoryStore::Append(int metric, const HistoryBucket& bucket) {
+    if (!IsOpen() || metric < 0 || (size_t)metric >= metric_names.size() || bucket.count == 0) return false;
+
+    int64_t day = DayOf(bucket.time);
+    if (!segment.map || segment.day != day) {
+        int64_t previous = segment.map ? segment.day : day;
+        UnmapSegment(segment);
+        if (previous < day) SealSegment(previous);
+        full_reported = false;
+        if (!MapSegment(segment, day, true)) return false;
+    }
+    if (segment.slots[metric] < 0) return false;
+
+    HistorySegmentHeader* header = segment.Header();
+    if (segment.count >= header->capacity) {
+        if (!full_reported) {
+            fprintf(stderr, "History segment %s is full\n", SegmentPath(day).c_str());
+            full_reported = true;
+        }
+        return false;
+    }
+
+    HistoryRecord& record = segment.Records()[segment.count];
+    HistoryRecord filled;
+    filled.time = bucket.time;
+    filled.min = bucket.min;
+    filled.max = bucket.max;
+    filled.average = bucket.Average();
+    filled.count = bucket.count;
+    filled.metric = (uint16_t)segment.slots[metric];
+    filled.checksum = filled.Checksum();
+    record = filled;
+
+    int hour = std::max(0, std::min(23, (int)((bucket.time - day * 86400.0) / 3600.0)));
+    if (header->hour_first[hour] == HistorySegmentHeader::NO_RECORD) {
+        header->hour_first[hour] = segment.count;
+    }
+    segment.count++;
+    return true;
+}
+int HistoryStore::AddMetric(const std::string& name) {
+    if (!IsOpen() || metric_names.size() >= (size_t)HistorySegmentHeader::MAX_METRICS) return -1;
+    metric_names.push_back(name.substr(0, HistorySegmentHeader::NAME_SIZE - 1));
+    if (segment.map) MapMetric(segment, metric_names.size() - 1, true);
+    return (int)metric_names.size() - 1;
+}
+#endif
@@ -6,8 +6,9 @@ bool g_running = true;
 
 void UpdateThread() {
     while (g_running) {
-        g_monitor.Update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        Collector& collector = g_monitor.GetCollector();
+        auto next_deadline = collector.RunScheduled();
+        collector.WaitUntil(next_deadline);
     }
 }
 
@@ -58,8 +59,17 @@ int main() {
     ImGui_ImplOpenGL3_Init("#version 130");
     printf("ImGui initialized successfully.\n");
     
+    // Settings are read before the update thread starts, since it may save the config
+    // Scrape endpoint, when metrics.port is set
+    MetricsServer metrics_server(g_monitor.GetCollector());
+    metrics_server.StartFromConfig(g_monitor.GetCollector().GetConfig());
+    ExportOptions export_options = ExportOptions::FromConfig(g_monitor.GetCollector().GetConfig());
+    
     // Start update thread
     std::thread update_thread(UpdateThread);
+    // Streaming export, when export.path is set
+    SnapshotExporter exporter(g_monitor.GetCollector());
+    exporter.Start(export_options);
     
     // Main loop
     bool done = false;
@@ -103,7 +113,10 @@ int main() {
     }
 
     // Cleanup
+    metrics_server.Stop();
+    exporter.Stop();
     g_running = false;
+    g_monitor.GetCollector().Wake();
     update_thread.join();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
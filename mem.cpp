@@ -1,8 +1,293 @@
-#include "header.h"
+#include "collector.h"
+
+// ProcessTable Implementation
+const uint32_t ProcessTable::EMPTY;
+const uint32_t ProcessTable::TOMBSTONE;
+
+// Only the pid is hashed so every row for a pid sits on one probe sequence,
+// which lets FindPid() work without knowing the starttime
+static inline size_t HashProcessKey(int pid) {
+    uint64_t h = (uint64_t)(uint32_t)pid * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+ProcessTable::ProcessTable() {
+    Rehash(1024);
+}
+
+size_t ProcessTable::Probe(int pid, uint64_t starttime) const {
+    // Returns the slot holding the key, or the slot an insert should use.
+    // The load factor is kept under 1/2 so an empty slot always ends the probe.
+    size_t mask = index.size() - 1;
+    size_t slot = HashProcessKey(pid) & mask;
+    size_t first_tombstone = SIZE_MAX;
+    while (true) {
+        const IndexEntry& entry = index[slot];
+        if (entry.row == EMPTY) {
+            return first_tombstone != SIZE_MAX ? first_tombstone : slot;
+        }
+        if (entry.row == TOMBSTONE) {
+            if (first_tombstone == SIZE_MAX) first_tombstone = slot;
+        } else if (entry.pid == pid && entry.starttime == starttime) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void ProcessTable::Rehash(size_t capacity) {
+    index.assign(capacity, IndexEntry{0, EMPTY, 0});
+    index_used = 0;
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+        if (!rows[r].alive) continue;
+        index[Probe(rows[r].pid, rows[r].starttime)] = IndexEntry{rows[r].pid, r, rows[r].starttime};
+        index_used++;
+    }
+}
+
+void ProcessTable::BeginUpdate() {
+    generation++;
+}
+
+ProcessInfo& ProcessTable::Upsert(int pid, uint64_t starttime, bool* inserted) {
+    size_t slot = Probe(pid, starttime);
+    IndexEntry& entry = index[slot];
+    if (entry.row < TOMBSTONE) {
+        ProcessInfo& row = rows[entry.row];
+        row.seen_generation = generation;
+        if (inserted) *inserted = false;
+        return row;
+    }
+
+    if (entry.row == EMPTY) index_used++;
+
+    uint32_t r;
+    if (!free_rows.empty()) {
+        r = free_rows.back();
+        free_rows.pop_back();
+    } else {
+        r = (uint32_t)rows.size();
+        rows.emplace_back();
+    }
+    entry = IndexEntry{pid, r, starttime};
+
+    // Tombstoned rows keep their string capacity for the next occupant
+    ProcessInfo& row = rows[r];
+    row.pid = pid;
+    row.starttime = starttime;
+    row.cpu_usage = 0.0f;
+    row.memory_usage = 0.0f;
+    row.cpu_sampled = false;
+    row.alive = true;
+    row.seen_generation = generation;
+    live_count++;
+    membership_version++;
+
+    if (index_used * 2 > index.size()) {
+        Rehash(live_count * 4 > index.size() ? index.size() * 2 : index.size());
+    }
+
+    if (inserted) *inserted = true;
+    return row;
+}
+
+void ProcessTable::EndUpdate() {
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].alive && rows[r].seen_generation != generation) {
+            Remove(r);
+        }
+    }
+}
+
+int ProcessTable::Find(int pid, uint64_t starttime) const {
+    const IndexEntry& entry = index[Probe(pid, starttime)];
+    return entry.row < TOMBSTONE ? (int)entry.row : -1;
+}
+
+int ProcessTable::FindPid(int pid) const {
+    size_t mask = index.size() - 1;
+    int found = -1;
+    for (size_t slot = HashProcessKey(pid) & mask; index[slot].row != EMPTY; slot = (slot + 1) & mask) {
+        const IndexEntry& entry = index[slot];
+        if (entry.row < TOMBSTONE && entry.pid == pid &&
+            (found < 0 || entry.starttime > rows[found].starttime)) {
+            found = (int)entry.row;
+        }
+    }
+    return found;
+}
+
+void ProcessTable::Remove(uint32_t row) {
+    if (row >= rows.size() || !rows[row].alive) return;
+
+    index[Probe(rows[row].pid, rows[row].starttime)].row = TOMBSTONE;
+    rows[row].alive = false;
+    free_rows.push_back(row);
+    live_count--;
+    membership_version++;
+}
 
 // MemoryManager Implementation
 MemoryManager::MemoryManager(SystemInfo* sys_info) : system_info_ref(sys_info) {
-    memset(process_filter, 0, sizeof(process_filter));
+#ifdef _WIN32
+    SYSTEM_INFO machine_info;
+    GetSystemInfo(&machine_info);
+    cpu_count = (int)machine_info.dwNumberOfProcessors;
+    cpu_ticks_per_second = 10000000.0; // FILETIME units
+#else
+    meminfo_source = sources.Register(ProcRoot() + "/meminfo");
+    cpu_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_ticks_per_second = (double)sysconf(_SC_CLK_TCK);
+    // The proc connector reports host processes, which a synthetic tree does not have
+    if (!UsingHostRoots()) track_process_events = false;
+    process_events_started = track_process_events;
+    if (process_events_started) proc_events.Start();
+#endif
+    if (cpu_count < 1) cpu_count = 1;
+    last_process_scan = std::chrono::steady_clock::now();
+    SetScanWorkers(std::min(cpu_count, 4));
+}
+
+MemoryManager::~MemoryManager() {
+#ifndef _WIN32
+    proc_events.Stop();
+    if (proc_fd >= 0) close(proc_fd);
+#endif
+}
+
+// Applied by the collector on its next tick
+void MemoryManager::SetTrackProcessEvents(bool track) {
+    track_process_events = track && UsingHostRoots();
+}
+
+bool MemoryManager::HasPendingEvents() const {
+#ifdef _WIN32
+    return false;
+#else
+    return proc_events.HasPending();
+#endif
+}
+
+void MemoryManager::SetEventNotify(std::function<void()> callback) {
+#ifndef _WIN32
+    proc_events.SetNotify(std::move(callback));
+#else
+    (void)callback;
+#endif
+}
+
+const int MemoryManager::EXIT_LOG_SIZE;
+constexpr float MemoryManager::SHORT_LIVED_SECONDS;
+
+// Applies queued proc connector events to the process table. Forks and
+// execs insert rows between scans; exits remove them and are logged with
+// their runtime, which is how sub-tick processes become visible at all.
+// The collector calls this as events arrive and again before each scan.
+void MemoryManager::ProcessEvents() {
+#ifndef _WIN32
+    bool track = track_process_events;
+    if (track != process_events_started) {
+        process_events_started = track;
+        if (track) {
+            proc_events.Start();
+        } else {
+            proc_events.Stop();
+            fork_times.clear();
+        }
+    }
+    
+    if (!proc_events.IsActive()) return;
+    proc_events.Drain(event_batch);
+    if (event_batch.empty()) return;
+    
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (const ProcEvent& event : event_batch) {
+        switch (event.type) {
+            case ProcEvent::FORK:
+                fork_times[event.pid] = event.timestamp_ns;
+                // fall through
+            case ProcEvent::EXEC:
+                if (event.has_stat) {
+                    ProcessInfo& proc = processes.Upsert(event.stat.pid, event.stat.starttime);
+                    if (proc.name != event.stat.comm) proc.name = event.stat.comm;
+                    proc.state.assign(1, event.stat.state);
+                    proc.memory_usage = (float)(event.stat.rss * page_size * 100.0 / system_info_ref->total_memory);
+                }
+                break;
+            case ProcEvent::EXIT: {
+                int row = processes.FindPid(event.pid);
+                
+                // Prefer the fork timestamp (same clock as the exit); fall back to starttime
+                float runtime = -1.0f;
+                auto fork_it = fork_times.find(event.pid);
+                if (fork_it != fork_times.end()) {
+                    if (event.timestamp_ns >= fork_it->second) {
+                        runtime = (float)((event.timestamp_ns - fork_it->second) / 1e9);
+                    }
+                    fork_times.erase(fork_it);
+                } else if (row >= 0) {
+                    // starttime is boottime and the event clock is monotonic; after a suspend they disagree
+                    double started = processes.Rows()[row].starttime / cpu_ticks_per_second;
+                    double elapsed = event.timestamp_ns / 1e9 - started;
+                    if (elapsed >= 0.0) runtime = (float)elapsed;
+                }
+                
+                if (recent_exits.size() < EXIT_LOG_SIZE) recent_exits.resize(EXIT_LOG_SIZE);
+                ProcessExit& exit = recent_exits[recent_exits_head];
+                recent_exits_head = (recent_exits_head + 1) % EXIT_LOG_SIZE;
+                exit.pid = event.pid;
+                exit.name = row >= 0 ? processes.Rows()[row].name : "?";
+                exit.runtime_seconds = runtime;
+                // Exit status, or the negated signal number when killed by a signal
+                exit.exit_code = (event.exit_code & 0x7f) ? -(event.exit_code & 0x7f) : (event.exit_code >> 8) & 0xff;
+                
+                if (runtime >= 0.0f && runtime < SHORT_LIVED_SECONDS) short_lived_processes++;
+                if (row >= 0) processes.Remove(row);
+                break;
+            }
+        }
+    }
+    
+    // Forks whose exit was dropped (socket overrun) would otherwise linger
+    if (fork_times.size() > processes.LiveCount() * 2 + 1024) {
+        for (auto it = fork_times.begin(); it != fork_times.end(); ) {
+            it = processes.FindPid(it->first) < 0 ? fork_times.erase(it) : std::next(it);
+        }
+    }
+#endif
+}
+
+// Applied by the collector on its next scan
+void MemoryManager::SetScanWorkers(int workers) {
+    scan_workers = std::max(1, std::min(workers, 64));
+}
+
+// Factor turning a CPU tick delta since the previous scan into a percentage.
+// Top-style by default, where a process can use more than 100%.
+float MemoryManager::ProcessCPUScale() {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - last_process_scan).count();
+    last_process_scan = now;
+    
+    if (elapsed <= 0.0) return 0.0f;
+    double scale = 100.0 / (elapsed * cpu_ticks_per_second);
+    if (cpu_per_core) scale /= cpu_count;
+    return (float)scale;
+}
+
+// Per-process CPU % from the tick delta; keyed by the table row, so a reused
+// pid starts from a fresh sample instead of producing a spike
+static void UpdateProcessCPU(ProcessInfo& proc, uint64_t ticks, float scale) {
+    if (proc.cpu_sampled && ticks >= proc.cpu_ticks) {
+        proc.cpu_usage = (float)(ticks - proc.cpu_ticks) * scale;
+    } else {
+        proc.cpu_usage = 0.0f;
+    }
+    proc.cpu_ticks = ticks;
+    proc.cpu_sampled = true;
 }
 
 void MemoryManager::Update() {
@@ -28,28 +313,35 @@ void MemoryManager::UpdateMemoryInfo() {
         system_info_ref->swap_usage = (float)(system_info_ref->used_swap * 100.0 / system_info_ref->total_swap);
     }
 #else
-    std::ifstream meminfo("/proc/meminfo");
-    std::string line;
-    std::map<std::string, uint64_t> mem_values;
+    if (sources.Read(meminfo_source, read_buffer) <= 0) return;
     
-    while (std::getline(meminfo, line)) {
-        std::istringstream iss(line);
-        std::string key;
-        uint64_t value;
-        std::string unit;
-        
-        if (iss >> key >> value >> unit) {
-            key.pop_back(); // Remove ':'
-            mem_values[key] = value * 1024; // Convert to bytes
+    uint64_t mem_total = 0, mem_available = 0, swap_total = 0, swap_free = 0;
+    struct { const char* key; size_t key_len; uint64_t* value; } fields[] = {
+        {"MemTotal:", 9, &mem_total},
+        {"MemAvailable:", 13, &mem_available},
+        {"SwapTotal:", 10, &swap_total},
+        {"SwapFree:", 9, &swap_free},
+    };
+    
+    // Lines look like "MemTotal:       16318812 kB"
+    for (const char* line = read_buffer.data(); *line; ) {
+        for (auto& field : fields) {
+            if (strncmp(line, field.key, field.key_len) == 0) {
+                *field.value = strtoull(line + field.key_len, nullptr, 10) * 1024; // Convert to bytes
+                break;
+            }
         }
+        const char* eol = strchr(line, '\n');
+        if (!eol) break;
+        line = eol + 1;
     }
     
-    system_info_ref->total_memory = mem_values["MemTotal"];
-    system_info_ref->used_memory = system_info_ref->total_memory - mem_values["MemAvailable"];
+    system_info_ref->total_memory = mem_total;
+    system_info_ref->used_memory = system_info_ref->total_memory - mem_available;
     system_info_ref->memory_usage = (float)(system_info_ref->used_memory * 100.0 / system_info_ref->total_memory);
     
-    system_info_ref->total_swap = mem_values["SwapTotal"];
-    system_info_ref->used_swap = system_info_ref->total_swap - mem_values["SwapFree"];
+    system_info_ref->total_swap = swap_total;
+    system_info_ref->used_swap = system_info_ref->total_swap - swap_free;
     if (system_info_ref->total_swap > 0) {
         system_info_ref->swap_usage = (float)(system_info_ref->used_swap * 100.0 / system_info_ref->total_swap);
     }
@@ -59,7 +351,8 @@ void MemoryManager::UpdateMemoryInfo() {
 void MemoryManager::UpdateProcesses() {
 #ifdef _WIN32
     // Windows process enumeration
-    processes.clear();
+    float cpu_scale = ProcessCPUScale();
+    processes.BeginUpdate();
     system_info_ref->total_processes = 0;
     system_info_ref->running_processes = 0;
     system_info_ref->sleeping_processes = 0;
@@ -75,8 +368,16 @@ void MemoryManager::UpdateProcesses() {
         for (DWORD i = 0; i < numProcesses; i++) {
             HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, process_ids[i]);
             if (hProcess) {
-                ProcessInfo proc;
-                proc.pid = process_ids[i];
+                // Creation time plays the role of starttime
+                FILETIME creation_time, exit_time, kernel_time, user_time;
+                uint64_t starttime = 0, cpu_time = 0;
+                if (GetProcessTimes(hProcess, &creation_time, &exit_time, &kernel_time, &user_time)) {
+                    starttime = ((uint64_t)creation_time.dwHighDateTime << 32) | creation_time.dwLowDateTime;
+                    cpu_time = (((uint64_t)kernel_time.dwHighDateTime << 32) | kernel_time.dwLowDateTime) +
+                               (((uint64_t)user_time.dwHighDateTime << 32) | user_time.dwLowDateTime);
+                }
+                
+                ProcessInfo& proc = processes.Upsert(process_ids[i], starttime);
                 
                 // Get process name
                 char processName[MAX_PATH];
@@ -93,76 +394,82 @@ void MemoryManager::UpdateProcesses() {
                 }
                 
                 proc.state = "R"; // Simplified for Windows
-                proc.cpu_usage = 0.0f; // Would need more complex implementation for real CPU usage
+                UpdateProcessCPU(proc, cpu_time, cpu_scale);
                 
-                processes.push_back(proc);
                 CloseHandle(hProcess);
             }
         }
     }
+    processes.EndUpdate();
 #else
-    processes.clear();
     system_info_ref->total_processes = 0;
     system_info_ref->running_processes = 0;
     system_info_ref->sleeping_processes = 0;
     system_info_ref->zombie_processes = 0;
     system_info_ref->stopped_processes = 0;
     
-    DIR* proc_dir = opendir("/proc");
-    if (!proc_dir) return;
+    // Apply lifecycle events queued since the last tick before rescanning
+    ProcessEvents();
     
-    struct dirent* entry;
-    while ((entry = readdir(proc_dir)) != nullptr) {
-        if (!isdigit(entry->d_name[0])) continue;
-        
-        int pid = std::stoi(entry->d_name);
-        std::string stat_path = "/proc/" + std::string(entry->d_name) + "/stat";
-        std::string status_path = "/proc/" + std::string(entry->d_name) + "/status";
-        
-        std::ifstream stat_file(stat_path);
-        if (!stat_file.is_open()) continue;
-        
-        std::string line;
-        std::getline(stat_file, line);
-        
-        std::istringstream iss(line);
-        std::string pid_str, comm, state;
-        long long utime, stime, cutime, cstime, starttime;
-        long vsize, rss;
-        
-        // Parse stat file for basic info
-        iss >> pid_str >> comm >> state;
-        for (int i = 0; i < 10; ++i) iss >> pid_str; // Skip fields
-        iss >> utime >> stime >> cutime >> cstime;
-        for (int i = 0; i < 4; ++i) iss >> pid_str; // Skip fields
-        iss >> starttime;
-        iss >> vsize >> rss;
-        
-        ProcessInfo proc;
-        proc.pid = pid;
-        proc.name = comm.substr(1, comm.length() - 2); // Remove parentheses
-        proc.state = state;
-        
-        // Calculate memory usage (RSS in pages, convert to percentage)
-        long page_size = sysconf(_SC_PAGESIZE);
-        proc.memory_usage = (float)(rss * page_size * 100.0 / system_info_ref->total_memory);
-        
-        // Simple CPU usage calculation (would need previous values for accurate calculation)
-        proc.cpu_usage = 0.0f;
-        
-        processes.push_back(proc);
-        system_info_ref->total_processes++;
-        
-        if (state == "R") system_info_ref->running_processes++;
-        else if (state == "S" || state == "I") system_info_ref->sleeping_processes++;
-        else if (state == "Z") system_info_ref->zombie_processes++;
-        else if (state == "T") system_info_ref->stopped_processes++;
+    // Keep /proc open across ticks and list pids with getdents64
+    if (proc_fd < 0) {
+        proc_fd = open(ProcRoot().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (proc_fd < 0) return;
     }
+    if (!ListProcPids(proc_fd, pid_list)) return;
     
-    closedir(proc_dir);
-#endif
+    // The calling thread takes a shard itself
+    int workers = scan_workers;
+    scan_pool.Resize(workers - 1);
+    
+    // Parse stat files in parallel shards, then merge on this thread
+    int shards = std::max(1, std::min(workers, (int)pid_list.size()));
+    ScanProcStats(proc_fd, pid_list, scan_pool, shards, scan_results);
+    
+    float cpu_scale = ProcessCPUScale();
+    long page_size = sysconf(_SC_PAGESIZE);
+    processes.BeginUpdate();
     
-    selected_processes.resize(processes.size(), false);
+    for (const auto& shard : scan_results) {
+        for (const ProcStat& stat : shard) {
+            // Existing rows are updated in place; the name only changes on exec
+            ProcessInfo& proc = processes.Upsert(stat.pid, stat.starttime);
+            if (proc.name != stat.comm) proc.name = stat.comm;
+            proc.state.assign(1, stat.state);
+            
+            // Calculate memory usage (RSS in pages, convert to percentage)
+            proc.memory_usage = (float)(stat.rss * page_size * 100.0 / system_info_ref->total_memory);
+            
+            UpdateProcessCPU(proc, stat.utime + stat.stime, cpu_scale);
+            
+            system_info_ref->total_processes++;
+            
+            switch (stat.state) {
+                case 'R': system_info_ref->running_processes++; break;
+                case 'S': case 'I': system_info_ref->sleeping_processes++; break;
+                case 'Z': system_info_ref->zombie_processes++; break;
+                case 'T': system_info_ref->stopped_processes++; break;
+            }
+        }
+    }
+    
+    processes.EndUpdate();
+#endif
+}
+
+void MemoryManager::WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const {
+    if (!stale[COLLECT_PROCESSES]) return;
+    snapshot.processes = processes.Rows();
+    snapshot.membership_version = processes.MembershipVersion();
+    FormatProcessText(snapshot);
+    snapshot.short_lived_processes = short_lived_processes;
+    snapshot.recent_exits = recent_exits;
+    snapshot.recent_exits_head = recent_exits_head;
+#ifndef _WIN32
+    snapshot.proc_events_active = proc_events.IsActive();
+    snapshot.proc_events_dropped = proc_events.GetDropped();
+    snapshot.proc_events_error = proc_events.GetError();
+#endif
 }
 
 void MemoryManager::UpdateDiskInfo() {
@@ -184,156 +491,3 @@ void MemoryManager::UpdateDiskInfo() {
     }
 #endif
 }
-
-std::string MemoryManager::FormatBytes(uint64_t bytes) {
-    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
-    int unit = 0;
-    double value = (double)bytes;
-    
-    while (value >= 1024.0 && unit < 4) {
-        value /= 1024.0;
-        unit++;
-    }
-    
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "%.2f %s", value, units[unit]);
-    return std::string(buffer);
-}
-
-void MemoryManager::RenderMemoryAndProcesses() {
-    // Memory usage section
-    ImGui::Text("Physical Memory (RAM):");
-    ImGui::ProgressBar(system_info_ref->memory_usage / 100.0f, ImVec2(0, 0), 
-                      (FormatBytes(system_info_ref->used_memory) + " / " + FormatBytes(system_info_ref->total_memory)).c_str());
-    
-    ImGui::Text("Virtual Memory (SWAP):");
-    ImGui::ProgressBar(system_info_ref->swap_usage / 100.0f, ImVec2(0, 0), 
-                      (FormatBytes(system_info_ref->used_swap) + " / " + FormatBytes(system_info_ref->total_swap)).c_str());
-    
-    ImGui::Text("Disk Usage:");
-    ImGui::ProgressBar(system_info_ref->disk_usage / 100.0f, ImVec2(0, 0), 
-                      (FormatBytes(system_info_ref->used_disk) + " / " + FormatBytes(system_info_ref->total_disk)).c_str());
-    
-    ImGui::Separator();
-    
-    // Process filter
-    ImGui::Text("Filter processes:");
-    ImGui::InputText("##filter", process_filter, sizeof(process_filter));
-    
-    // Process controls
-    ImGui::SameLine();
-    if (ImGui::Button("Refresh")) {
-        UpdateProcesses();
-    }
-    
-    // Process statistics
-    ImGui::Text("Total: %d | Running: %d | Sleeping: %d | Zombie: %d | Stopped: %d", 
-               system_info_ref->total_processes, system_info_ref->running_processes,
-               system_info_ref->sleeping_processes, system_info_ref->zombie_processes,
-               system_info_ref->stopped_processes);
-    
-    ImGui::Separator();
-    
-    // Process table
-    if (ImGui::BeginTable("ProcessTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
-                         ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY)) {
-        ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_DefaultSort);
-        ImGui::TableSetupColumn("Name");
-        ImGui::TableSetupColumn("State");
-        ImGui::TableSetupColumn("CPU %");
-        ImGui::TableSetupColumn("Memory %");
-        ImGui::TableHeadersRow();
-        
-        std::string filter_str = std::string(process_filter);
-        std::transform(filter_str.begin(), filter_str.end(), filter_str.begin(), ::tolower);
-        
-        // Sort processes if needed
-        if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
-            if (sort_specs->SpecsDirty) {
-                std::sort(processes.begin(), processes.end(), [&](const ProcessInfo& a, const ProcessInfo& b) {
-                    for (int n = 0; n < sort_specs->SpecsCount; n++) {
-                        const ImGuiTableColumnSortSpecs* sort_spec = &sort_specs->Specs[n];
-                        int delta = 0;
-                        switch (sort_spec->ColumnIndex) {
-                            case 0: delta = (a.pid < b.pid) ? -1 : (a.pid > b.pid) ? 1 : 0; break;
-                            case 1: delta = a.name.compare(b.name); break;
-                            case 2: delta = a.state.compare(b.state); break;
-                            case 3: delta = (a.cpu_usage < b.cpu_usage) ? -1 : (a.cpu_usage > b.cpu_usage) ? 1 : 0; break;
-                            case 4: delta = (a.memory_usage < b.memory_usage) ? -1 : (a.memory_usage > b.memory_usage) ? 1 : 0; break;
-                        }
-                        if (delta != 0)
-                            return (sort_spec->SortDirection == ImGuiSortDirection_Ascending) ? (delta < 0) : (delta > 0);
-                    }
-                    return a.pid < b.pid;
-                });
-                sort_specs->SpecsDirty = false;
-            }
-        }
-        
-        for (size_t i = 0; i < processes.size(); ++i) {
-            const auto& proc = processes[i];
-            
-            // Apply filter
-            if (!filter_str.empty()) {
-                std::string proc_name = proc.name;
-                std::transform(proc_name.begin(), proc_name.end(), proc_name.begin(), ::tolower);
-                if (proc_name.find(filter_str) == std::string::npos && 
-                    std::to_string(proc.pid).find(filter_str) == std::string::npos) {
-                    continue;
-                }
-            }
-            
-            ImGui::TableNextRow();
-            
-            // Selectable row
-            ImGui::TableSetColumnIndex(0);
-            if (ImGui::Selectable(std::to_string(proc.pid).c_str(), selected_processes[i], 
-                                 ImGuiSelectableFlags_SpanAllColumns)) {
-                selected_processes[i] = !selected_processes[i];
-            }
-            
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%s", proc.name.c_str());
-            
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%s", proc.state.c_str());
-            
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%.1f", proc.cpu_usage);
-            
-            ImGui::TableSetColumnIndex(4);
-            ImGui::Text("%.2f", proc.memory_usage);
-        }
-        
-        ImGui::EndTable();
-    }
-    
-    // Process actions
-    if (ImGui::Button("Kill Selected")) {
-        KillSelectedProcesses();
-    }
-    ImGui::SameLine();
-    if (ImGui::Button("Clear Selection")) {
-        std::fill(selected_processes.begin(), selected_processes.end(), false);
-    }
-}
-
-void MemoryManager::KillSelectedProcesses() {
-    for (size_t i = 0; i < processes.size() && i < selected_processes.size(); ++i) {
-        if (selected_processes[i]) {
-#ifdef _WIN32
-            HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, processes[i].pid);
-            if (hProcess) {
-                TerminateProcess(hProcess, 1);
-                CloseHandle(hProcess);
-            }
-#else
-            kill(processes[i].pid, SIGTERM);
-#endif
-        }
-    }
-    // Clear selection after killing
-    std::fill(selected_processes.begin(), selected_processes.end(), false);
-    // Refresh process list
-    UpdateProcesses();
-}
\ No newline at end of file
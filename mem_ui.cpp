@@ -0,0 +1,390 @@
+#include "header.h"
+
+void MemoryView::RenderMemoryAndProcesses(const MonitorSnapshot& snapshot) {
+    // Memory usage section
+    ImGui::Text("Physical Memory (RAM):");
+    ImGui::ProgressBar(snapshot.system_info.memory_usage / 100.0f, ImVec2(0, 0),
+                      snapshot.system_text.Get(snapshot.memory_usage_text));
+    
+    ImGui::Text("Virtual Memory (SWAP):");
+    ImGui::ProgressBar(snapshot.system_info.swap_usage / 100.0f, ImVec2(0, 0),
+                      snapshot.system_text.Get(snapshot.swap_usage_text));
+    
+    ImGui::Text("Disk Usage:");
+    ImGui::ProgressBar(snapshot.system_info.disk_usage / 100.0f, ImVec2(0, 0),
+                      snapshot.system_text.Get(snapshot.disk_usage_text));
+    
+    ImGui::Separator();
+    
+    // Process filter
+    ImGui::Text("Filter processes:");
+    ImGui::InputText("##filter", process_filter, sizeof(process_filter));
+    
+    // Process controls
+    ImGui::SameLine();
+    if (ImGui::Button("Refresh")) {
+        g_monitor.GetCollector().RequestUpdate();
+    }
+    ImGui::SameLine();
+    bool per_core = manager.GetCPUPerCore();
+    if (ImGui::Checkbox("CPU % per core", &per_core)) {
+        manager.SetCPUPerCore(per_core);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Divide process CPU %% by the number of cores (%d).\n"
+                          "Unchecked, a process can exceed 100%% like in top.", manager.GetCPUCount());
+    }
+#ifndef _WIN32
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120);
+    int workers = manager.GetScanWorkers();
+    if (ImGui::SliderInt("Scan threads", &workers, 1, 16)) {
+        manager.SetScanWorkers(workers);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Threads used to read /proc/<pid> during a process scan.");
+    }
+#endif
+    
+    // Process statistics
+    ImGui::Text("Total: %d | Running: %d | Sleeping: %d | Zombie: %d | Stopped: %d", 
+               snapshot.system_info.total_processes, snapshot.system_info.running_processes,
+               snapshot.system_info.sleeping_processes, snapshot.system_info.zombie_processes,
+               snapshot.system_info.stopped_processes);
+    
+    // Process lifecycle events
+    bool track_events = manager.GetTrackProcessEvents();
+    if (ImGui::Checkbox("Track process events", &track_events)) {
+        manager.SetTrackProcessEvents(track_events);
+    }
+    ImGui::SameLine();
+#ifndef _WIN32
+    if (snapshot.proc_events_active) {
+        ImGui::Text("Short-lived processes (< %.0f s): %d", MemoryManager::SHORT_LIVED_SECONDS, snapshot.short_lived_processes);
+        if (snapshot.proc_events_dropped > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%llu events dropped)", (unsigned long long)snapshot.proc_events_dropped);
+        }
+    } else if (manager.GetTrackProcessEvents()) {
+        ImGui::TextDisabled("Unavailable (%s), polling only", snapshot.proc_events_error.c_str());
+    } else {
+        ImGui::TextDisabled("Polling only");
+    }
+#else
+    ImGui::TextDisabled("Not supported on this platform, polling only");
+#endif
+    if (ImGui::CollapsingHeader("Recent exits")) {
+        RenderProcessExits(snapshot);
+    }
+    
+    ImGui::Separator();
+    
+    // Process table
+    if (ImGui::BeginTable("ProcessTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
+                         ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY)) {
+        ScopedLatency timer(g_monitor.GetRenderLatency(RENDER_PROCESS_TABLE));
+        ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_DefaultSort);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("State");
+        ImGui::TableSetupColumn("CPU %");
+        ImGui::TableSetupColumn("Memory %");
+        ImGui::TableHeadersRow();
+        
+        filter_lower.assign(process_filter);
+        std::transform(filter_lower.begin(), filter_lower.end(), filter_lower.begin(), ::tolower);
+        
+        const auto& rows = snapshot.processes;
+        bool order_changed = RefreshDisplayOrder(snapshot);
+        
+        // Fresh values move only a few rows each tick, so the order is kept
+        // sorted with the cheap re-sort; a new sort column needs a full one
+        if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
+            uint64_t version = snapshot.versions[COLLECT_PROCESSES];
+            if (sort_specs->SpecsDirty) {
+                SortDisplayOrder(rows, sort_specs);
+                sort_specs->SpecsDirty = false;
+            } else if (order_changed || sorted_version != version) {
+                SortDisplayOrder(rows, sort_specs, true);
+            }
+            sorted_version = version;
+        }
+        
+        const std::vector<uint32_t>& shown = FilterDisplayOrder(snapshot, filter_lower);
+        
+        // Only the rows in view are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin((int)shown.size());
+        while (clipper.Step()) {
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; ++n) {
+                uint32_t i = shown[n];
+                const auto& proc = rows[i];
+                const ProcessText& cells = snapshot.process_cells[i];
+                
+                ImGui::TableNextRow();
+                
+                // Selectable row; a reused pid does not inherit the selection
+                auto key = std::make_pair(proc.pid, proc.starttime);
+                bool selected = selected_processes.count(key) > 0;
+                ImGui::TableSetColumnIndex(0);
+                if (ImGui::Selectable(snapshot.process_text.Get(cells.pid), selected,
+                                      ImGuiSelectableFlags_SpanAllColumns)) {
+                    if (selected) selected_processes.erase(key);
+                    else selected_processes.insert(key);
+                }
+                
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextUnformatted(proc.name.c_str());
+                
+                ImGui::TableSetColumnIndex(2);
+                ImGui::TextUnformatted(proc.state.c_str());
+                
+                ImGui::TableSetColumnIndex(3);
+                ImGui::TextUnformatted(snapshot.process_text.Get(cells.cpu));
+                
+                ImGui::TableSetColumnIndex(4);
+                ImGui::TextUnformatted(snapshot.process_text.Get(cells.memory));
+            }
+        }
+        
+        ImGui::EndTable();
+    }
+    
+    // Process actions
+    if (ImGui::Button("Kill Selected")) {
+        KillSelectedProcesses(snapshot);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Selection")) {
+        selected_processes.clear();
+    }
+}
+
+// Follow processes coming and going. Rows still alive keep their place and
+// new ones go at the end, so the order stays nearly sorted for the re-sort.
+bool MemoryView::RefreshDisplayOrder(const MonitorSnapshot& snapshot) {
+    if (display_version == snapshot.membership_version) return false;
+    const auto& rows = snapshot.processes;
+    row_listed.assign(rows.size(), 0);
+    size_t kept = 0;
+    for (uint32_t r : display_order) {
+        if (r < rows.size() && rows[r].alive && !row_listed[r]) {
+            row_listed[r] = 1;
+            display_order[kept++] = r;
+        }
+    }
+    display_order.resize(kept);
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].alive && !row_listed[r]) display_order.push_back(r);
+    }
+    
+    // Forget selected processes that have exited
+    if (!selected_processes.empty()) {
+        std::set<std::pair<int, uint64_t>> still_alive;
+        for (uint32_t r : display_order) {
+            auto key = std::make_pair(rows[r].pid, rows[r].starttime);
+            if (selected_processes.count(key)) still_alive.insert(key);
+        }
+        selected_processes.swap(still_alive);
+    }
+    
+    display_version = snapshot.membership_version;
+    order_version++;
+    return true;
+}
+
+static bool ProcessLess(const ProcessInfo& a, const ProcessInfo& b, const ImGuiTableSortSpecs* sort_specs) {
+    for (int n = 0; n < sort_specs->SpecsCount; n++) {
+        const ImGuiTableColumnSortSpecs* sort_spec = &sort_specs->Specs[n];
+        int delta = 0;
+        switch (sort_spec->ColumnIndex) {
+            case 0: delta = (a.pid < b.pid) ? -1 : (a.pid > b.pid) ? 1 : 0; break;
+            case 1: delta = a.name.compare(b.name); break;
+            case 2: delta = a.state.compare(b.state); break;
+            case 3: delta = (a.cpu_usage < b.cpu_usage) ? -1 : (a.cpu_usage > b.cpu_usage) ? 1 : 0; break;
+            case 4: delta = (a.memory_usage < b.memory_usage) ? -1 : (a.memory_usage > b.memory_usage) ? 1 : 0; break;
+        }
+        if (delta != 0)
+            return (sort_spec->SortDirection == ImGuiSortDirection_Ascending) ? (delta < 0) : (delta > 0);
+    }
+    return a.pid < b.pid;
+}
+
+void MemoryView::SortDisplayOrder(const std::vector<ProcessInfo>& rows, const ImGuiTableSortSpecs* sort_specs,
+                                  bool nearly_sorted) {
+    auto less = [&](uint32_t ia, uint32_t ib) { return ProcessLess(rows[ia], rows[ib], sort_specs); };
+    order_version++;
+    
+    if (nearly_sorted) {
+        // Drop-merge sort: rows still in order stay put, the few that moved
+        // are sorted on their own and merged back in. A run of rows falling
+        // below the last one kept means that row is the one that moved.
+        const size_t RECENCY = 8;
+        size_t count = display_order.size();
+        size_t max_moved = count / 8 + 16;
+        size_t dropped_in_row = 0;
+        sort_kept.clear();
+        sort_moved.clear();
+        for (size_t i = 0; i < count && sort_moved.size() <= max_moved;) {
+            uint32_t r = display_order[i];
+            if (sort_kept.empty() || !less(r, sort_kept.back())) {
+                sort_kept.push_back(r);
+                dropped_in_row = 0;
+                ++i;
+            } else if (dropped_in_row == 0 && sort_kept.size() >= 2 && !less(r, sort_kept[sort_kept.size() - 2])) {
+                // r fits before the last row kept; guess that one moved
+                sort_moved.push_back(sort_kept.back());
+                sort_kept.back() = r;
+                ++i;
+            } else if (dropped_in_row < RECENCY) {
+                sort_moved.push_back(r);
+                dropped_in_row++;
+                ++i;
+            } else {
+                // Take the run back and move the last row kept instead
+                sort_moved.resize(sort_moved.size() - dropped_in_row);
+                i -= dropped_in_row;
+                sort_moved.push_back(sort_kept.back());
+                sort_kept.pop_back();
+                dropped_in_row = 0;
+            }
+        }
+        if (sort_moved.size() <= max_moved) {
+            std::sort(sort_moved.begin(), sort_moved.end(), less);
+            std::merge(sort_kept.begin(), sort_kept.end(), sort_moved.begin(), sort_moved.end(), display_order.begin(),
+                       less);
+            return;
+        }
+        // Too much has changed for the merge to pay off
+    }
+    std::sort(display_order.begin(), display_order.end(), less);
+}
+
+bool MemoryView::RefreshSearchCache(const MonitorSnapshot& snapshot) {
+    if (search_version == snapshot.versions[COLLECT_PROCESSES] && search_cache.size() == snapshot.processes.size()) {
+        return false;
+    }
+    search_version = snapshot.versions[COLLECT_PROCESSES];
+    
+    const auto& rows = snapshot.processes;
+    search_cache.resize(rows.size());
+    bool changed = false;
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+        const ProcessInfo& proc = rows[r];
+        SearchEntry& entry = search_cache[r];
+        if (!proc.alive || (entry.pid == proc.pid && entry.name == proc.name)) continue;
+        
+        entry.pid = proc.pid;
+        entry.name = proc.name;
+        entry.text.assign(proc.name);
+        std::transform(entry.text.begin(), entry.text.end(), entry.text.begin(), ::tolower);
+        entry.text.push_back('\x1f');
+        char pid_text[16];
+        entry.text.append(pid_text, std::to_chars(pid_text, pid_text + sizeof(pid_text), proc.pid).ptr);
+        entry.matches = applied_filter.empty() || entry.text.find(applied_filter) != std::string::npos;
+        changed = true;
+    }
+    return changed;
+}
+
+const std::vector<uint32_t>& MemoryView::FilterDisplayOrder(const MonitorSnapshot& snapshot, const std::string& filter) {
+    bool rows_changed = RefreshSearchCache(snapshot);
+    if (filter.empty()) {
+        applied_filter.clear();
+        return display_order;
+    }
+    
+    // A row that comes back into the display order may carry a match against an older query
+    bool membership_changed = filtered_membership != display_version;
+    if (filter != applied_filter || membership_changed) {
+        // A query containing the previous one can only match a subset of its
+        // rows, as long as those rows are still the ones filtered_rows holds
+        bool narrowing = !applied_filter.empty() && filter != applied_filter &&
+                         filter.find(applied_filter) != std::string::npos && !rows_changed && !membership_changed;
+        for (uint32_t r : narrowing ? filtered_rows : display_order) {
+            search_cache[r].matches = search_cache[r].text.find(filter) != std::string::npos;
+        }
+        if (narrowing) {
+            filtered_rows.erase(std::remove_if(filtered_rows.begin(), filtered_rows.end(),
+                                               [&](uint32_t r) { return !search_cache[r].matches; }),
+                                filtered_rows.end());
+        }
+        applied_filter = filter;
+        filtered_membership = display_version;
+        rows_changed = !narrowing;
+    }
+    
+    if (rows_changed || filtered_order_version != order_version) {
+        filtered_rows.clear();
+        for (uint32_t r : display_order) {
+            if (search_cache[r].matches) filtered_rows.push_back(r);
+        }
+        filtered_order_version = order_version;
+    }
+    return filtered_rows;
+}
+
+void MemoryView::RenderProcessExits(const MonitorSnapshot& snapshot) {
+    const auto& recent_exits = snapshot.recent_exits;
+    if (recent_exits.empty()) {
+        ImGui::TextDisabled("No exits recorded yet");
+        return;
+    }
+    
+    if (ImGui::BeginTable("ExitTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                          ImVec2(0, 150))) {
+        ImGui::TableSetupColumn("PID");
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Runtime");
+        ImGui::TableSetupColumn("Exit");
+        ImGui::TableHeadersRow();
+        
+        // Newest first
+        for (size_t n = 1; n <= recent_exits.size(); ++n) {
+            const ProcessExit& exit = recent_exits[(snapshot.recent_exits_head + recent_exits.size() - n) % recent_exits.size()];
+            if (exit.pid == 0) break;
+            
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%d", exit.pid);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", exit.name.c_str());
+            ImGui::TableSetColumnIndex(2);
+            if (exit.runtime_seconds < 0.0f) {
+                ImGui::TextDisabled("unknown");
+            } else if (exit.runtime_seconds < 1.0f) {
+                ImGui::Text("%.1f ms", exit.runtime_seconds * 1000.0f);
+            } else {
+                ImGui::Text("%.1f s", exit.runtime_seconds);
+            }
+            ImGui::TableSetColumnIndex(3);
+            if (exit.exit_code < 0) {
+                ImGui::Text("signal %d", -exit.exit_code);
+            } else {
+                ImGui::Text("%d", exit.exit_code);
+            }
+        }
+        
+        ImGui::EndTable();
+    }
+}
+
+void MemoryView::KillSelectedProcesses(const MonitorSnapshot& snapshot) {
+    const auto& rows = snapshot.processes;
+    for (size_t i = 0; i < rows.size() && !selected_processes.empty(); ++i) {
+        if (rows[i].alive && selected_processes.count(std::make_pair(rows[i].pid, rows[i].starttime))) {
+#ifdef _WIN32
+            HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, rows[i].pid);
+            if (hProcess) {
+                TerminateProcess(hProcess, 1);
+                CloseHandle(hProcess);
+            }
+#else
+            kill(rows[i].pid, SIGTERM);
+#endif
+        }
+    }
+    // Clear selection after killing
+    selected_processes.clear();
+    // Refresh process list
+    g_monitor.GetCollector().RequestUpdate();
+}
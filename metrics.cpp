@@ -0,0 +1,423 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <poll.h>
+#endif
+
+// MetricsServer Implementation
+const int MetricsServer::DEFAULT_PORT;
+const int MetricsServer::DEFAULT_TOP_PROCESSES;
+const int MetricsServer::MAX_CLIENTS;
+const size_t MetricsServer::MAX_REQUEST;
+
+// OpenMetrics spells NaN out
+static void AppendValue(std::vector<char>& out, float value) {
+    if (std::isnan(value)) AppendText(out, "NaN");
+    else AppendNumber(out, value);
+}
+
+template <typename T>
+static void AppendValue(std::vector<char>& out, T value) {
+    AppendNumber(out, value);
+}
+
+// Label values escape backslash, double quote and newline
+static void AppendLabelValue(std::vector<char>& out, const std::string& value) {
+    for (char c : value) {
+        if (c == '\\') AppendText(out, "\\\\", 2);
+        else if (c == '"') AppendText(out, "\\\"", 2);
+        else if (c == '\n') AppendText(out, "\\n", 2);
+        else out.push_back(c);
+    }
+}
+
+static void AppendFamily(std::vector<char>& out, const char* name, const char* type, const char* help) {
+    AppendText(out, "# TYPE ");
+    AppendText(out, name);
+    out.push_back(' ');
+    AppendText(out, type);
+    AppendText(out, "\n# HELP ");
+    AppendText(out, name);
+    out.push_back(' ');
+    AppendText(out, help);
+    out.push_back('\n');
+}
+
+template <typename T>
+static void AppendSample(std::vector<char>& out, const char* name, T value) {
+    AppendText(out, name);
+    out.push_back(' ');
+    AppendValue(out, value);
+    out.push_back('\n');
+}
+
+template <typename T>
+static void AppendGauge(std::vector<char>& out, const char* name, const char* help, T value) {
+    AppendFamily(out, name, "gauge", help);
+    AppendSample(out, name, value);
+}
+
+void MetricsServer::RenderMetrics(const MonitorSnapshot& snapshot, std::vector<char>& out) {
+    const SystemInfo& info = snapshot.system_info;
+    const CPUTimes& cpu = snapshot.cpu_times;
+
+    AppendGauge(out, "sysmon_cpu_usage_percent", "Busy CPU time of the whole machine.", info.cpu_usage);
+    if (cpu.slots > 0) {
+        AppendFamily(out, "sysmon_cpu_mode_percent", "gauge", "Share of CPU time by mode, whole machine.");
+        for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+            AppendText(out, "sysmon_cpu_mode_percent{mode=\"");
+            AppendText(out, CPUTimes::ShareName(s));
+            AppendText(out, "\"} ");
+            AppendValue(out, cpu.percent[s][0]);
+            out.push_back('\n');
+        }
+        AppendFamily(out, "sysmon_cpu_core_busy_percent", "gauge", "Busy time of each core.");
+        for (int core = 0; core < cpu.CoreCount(); ++core) {
+            AppendText(out, "sysmon_cpu_core_busy_percent{core=\"");
+            AppendNumber(out, cpu.CoreId(core));
+            AppendText(out, "\"} ");
+            AppendValue(out, cpu.busy[core + 1]);
+            out.push_back('\n');
+        }
+    }
+
+    AppendGauge(out, "sysmon_memory_total_bytes", "Physical memory.", info.total_memory);
+    AppendGauge(out, "sysmon_memory_used_bytes", "Physical memory in use.", info.used_memory);
+    AppendGauge(out, "sysmon_swap_total_bytes", "Swap space.", info.total_swap);
+    AppendGauge(out, "sysmon_swap_used_bytes", "Swap space in use.", info.used_swap);
+    AppendGauge(out, "sysmon_disk_total_bytes", "Size of the root filesystem.", info.total_disk);
+    AppendGauge(out, "sysmon_disk_used_bytes", "Used space on the root filesystem.", info.used_disk);
+    AppendGauge(out, "sysmon_temperature_celsius", "CPU temperature.", info.temperature);
+    if (!info.thermal_zones.empty()) {
+        AppendFamily(out, "sysmon_thermal_zone_celsius", "gauge", "Temperature of each thermal zone.");
+        for (const ThermalZone& zone : info.thermal_zones) {
+            AppendText(out, "sysmon_thermal_zone_celsius{zone=\"");
+            AppendNumber(out, zone.zone);
+            AppendText(out, "\"} ");
+            AppendValue(out, zone.temperature);
+            out.push_back('\n');
+        }
+    }
+    AppendGauge(out, "sysmon_fan_speed_rpm", "Fan speed.", info.fan_speed);
+
+    AppendFamily(out, "sysmon_processes", "gauge", "Processes by state.");
+    const std::pair<const char*, int> states[] = {
+        {"running", info.running_processes}, {"sleeping", info.sleeping_processes},
+        {"zombie", info.zombie_processes}, {"stopped", info.stopped_processes},
+    };
+    for (const auto& state : states) {
+        AppendText(out, "sysmon_processes{state=\"");
+        AppendText(out, state.first);
+        AppendText(out, "\"} ");
+        AppendNumber(out, state.second);
+        out.push_back('\n');
+    }
+
+    // Interface counters; OpenMetrics counter samples carry the _total suffix
+    struct CounterField {
+        const char* name;
+        const char* help;
+        uint64_t NetworkInterface::*field;
+    };
+    static const CounterField counters[] = {
+        {"sysmon_network_receive_bytes", "Bytes received.", &NetworkInterface::rx_bytes},
+        {"sysmon_network_transmit_bytes", "Bytes transmitted.", &NetworkInterface::tx_bytes},
+        {"sysmon_network_receive_packets", "Packets received.", &NetworkInterface::rx_packets},
+        {"sysmon_network_transmit_packets", "Packets transmitted.", &NetworkInterface::tx_packets},
+        {"sysmon_network_receive_errors", "Receive errors.", &NetworkInterface::rx_errs},
+        {"sysmon_network_transmit_errors", "Transmit errors.", &NetworkInterface::tx_errs},
+        {"sysmon_network_receive_drops", "Received packets dropped.", &NetworkInterface::rx_drop},
+        {"sysmon_network_transmit_drops", "Transmitted packets dropped.", &NetworkInterface::tx_drop},
+    };
+    for (const CounterField& counter : counters) {
+        AppendFamily(out, counter.name, "counter", counter.help);
+        for (const NetworkInterface& iface : snapshot.network_interfaces) {
+            AppendText(out, counter.name);
+            AppendText(out, "_total{interface=\"");
+            AppendLabelValue(out, iface.name);
+            AppendText(out, "\"} ");
+            AppendNumber(out, iface.*counter.field);
+            out.push_back('\n');
+        }
+    }
+
+    // Top processes by CPU; nth_element keeps this linear in the process count
+    const auto& rows = snapshot.processes;
+    process_order.clear();
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].alive) process_order.push_back(r);
+    }
+    auto busier = [&](uint32_t a, uint32_t b) {
+        if (rows[a].cpu_usage != rows[b].cpu_usage) return rows[a].cpu_usage > rows[b].cpu_usage;
+        return rows[a].pid < rows[b].pid;
+    };
+    size_t shown = std::min(process_order.size(), (size_t)std::max(0, top_processes));
+    if (shown < process_order.size()) {
+        std::nth_element(process_order.begin(), process_order.begin() + shown, process_order.end(), busier);
+    }
+    std::sort(process_order.begin(), process_order.begin() + shown, busier);
+
+    const char* process_families[2][2] = {
+        {"sysmon_process_cpu_percent", "CPU usage of the busiest processes."},
+        {"sysmon_process_memory_percent", "Memory usage of the busiest processes."},
+    };
+    for (int family = 0; family < 2; ++family) {
+        AppendFamily(out, process_families[family][0], "gauge", process_families[family][1]);
+        for (size_t i = 0; i < shown; ++i) {
+            const ProcessInfo& proc = rows[process_order[i]];
+            AppendText(out, process_families[family][0]);
+            AppendText(out, "{pid=\"");
+            AppendNumber(out, proc.pid);
+            AppendText(out, "\",name=\"");
+            AppendLabelValue(out, proc.name);
+            AppendText(out, "\"} ");
+            AppendValue(out, family == 0 ? proc.cpu_usage : proc.memory_usage);
+            out.push_back('\n');
+        }
+    }
+
+    // The monitor's own cost
+    AppendFamily(out, "sysmon_self_cpu_seconds", "counter", "CPU time used by the monitor.");
+    AppendSample(out, "sysmon_self_cpu_seconds_total", snapshot.self.cpu_seconds);
+    AppendGauge(out, "sysmon_self_resident_bytes", "Resident memory of the monitor.", snapshot.self.resident_bytes);
+    AppendGauge(out, "sysmon_self_threads", "Threads of the monitor.", snapshot.self.threads);
+
+    static const double quantiles[] = {0.5, 0.99};
+    AppendFamily(out, "sysmon_collector_duration_seconds", "summary", "Time spent in each collector since start.");
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        const LatencyHistogram& latency = collector.GetCollectorLatency(c);
+        for (double quantile : quantiles) {
+            AppendText(out, "sysmon_collector_duration_seconds{collector=\"");
+            AppendText(out, CollectorScheduler::Name(c));
+            AppendText(out, "\",quantile=\"");
+            AppendNumber(out, quantile);
+            AppendText(out, "\"} ");
+            AppendValue(out, latency.PercentileNs(quantile * 100.0) / 1e9);
+            out.push_back('\n');
+        }
+        const char* suffixes[2] = {"_sum{collector=\"", "_count{collector=\""};
+        for (int s = 0; s < 2; ++s) {
+            AppendText(out, "sysmon_collector_duration_seconds");
+            AppendText(out, suffixes[s]);
+            AppendText(out, CollectorScheduler::Name(c));
+            AppendText(out, "\"} ");
+            if (s == 0) AppendValue(out, latency.SumNs() / 1e9);
+            else AppendValue(out, latency.Count());
+            out.push_back('\n');
+        }
+    }
+
+    AppendText(out, "# EOF\n");
+}
+
+bool MetricsServer::StartFromConfig(const Config& config) {
+    int port = config.GetInt("metrics.port", 0);
+    if (port <= 0) return false;
+    return Start(config.Get("metrics.address", "127.0.0.1"), port,
+                 config.GetInt("metrics.top_processes", DEFAULT_TOP_PROCESSES));
+}
+
+#ifdef _WIN32
+// No socket backend on Windows yet
+bool MetricsServer::Start(const std::string& address, int port, int max_processes) {
+    (void)address;
+    (void)port;
+    (void)max_processes;
+    return false;
+}
+
+void MetricsServer::Stop() {}
+#else
+bool MetricsServer::Start(const std::string& address, int port, int max_processes) {
+    Stop();
+
+    sockaddr_in bind_address = {};
+    bind_address.sin_family = AF_INET;
+    bind_address.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, address.c_str(), &bind_address.sin_addr) != 1) {
+        fprintf(stderr, "metrics: bad listen address %s\n", address.c_str());
+        return false;
+    }
+
+    listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) return false;
+    int reuse = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(listen_fd, (sockaddr*)&bind_address, sizeof(bind_address)) != 0 || listen(listen_fd, MAX_CLIENTS) != 0 ||
+        pipe2(wake_pipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+        fprintf(stderr, "metrics: cannot listen on %s:%d: %s\n", address.c_str(), port, strerror(errno));
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    top_processes = max_processes;
+    running = true;
+    thread = std::thread(&MetricsServer::Run, this);
+    return true;
+}
+
+void MetricsServer::Stop() {
+    if (thread.joinable()) {
+        running = false;
+        ssize_t written = write(wake_pipe[1], "x", 1);
+        (void)written;
+        thread.join();
+    }
+    for (auto& client : clients) close(client->fd);
+    clients.clear();
+    if (listen_fd >= 0) close(listen_fd);
+    for (int& fd : wake_pipe) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    listen_fd = -1;
+}
+
+void MetricsServer::Run() {
+    std::vector<pollfd> fds;
+    std::vector<bool> keep;
+    while (running) {
+        // [0] wake pipe, [1] listener, then one entry per client
+        fds.clear();
+        fds.push_back({wake_pipe[0], POLLIN, 0});
+        fds.push_back({listen_fd, (short)(clients.size() < (size_t)MAX_CLIENTS ? POLLIN : 0), 0});
+        for (const auto& client : clients) {
+            fds.push_back({client->fd, (short)(client->responding ? POLLOUT : POLLIN), 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            char drain[16];
+            while (read(wake_pipe[0], drain, sizeof(drain)) > 0) {}
+        }
+
+        keep.assign(clients.size(), true);
+        for (size_t i = 0; i < clients.size(); ++i) {
+            short revents = fds[i + 2].revents;
+            Client& client = *clients[i];
+            if (revents & (POLLERR | POLLNVAL)) keep[i] = false;
+            else if (revents & POLLOUT) keep[i] = WriteResponse(client);
+            else if (revents & (POLLIN | POLLHUP)) keep[i] = ReadRequest(client);
+        }
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (keep[i]) continue;
+            close(clients[i]->fd);
+            clients.erase(clients.begin() + i);
+        }
+
+        if (fds[1].revents & POLLIN) Accept();
+    }
+}
+
+void MetricsServer::Accept() {
+    while (clients.size() < (size_t)MAX_CLIENTS) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        clients.push_back(std::move(client));
+    }
+}
+
+bool MetricsServer::ReadRequest(Client& client) {
+    while (true) {
+        if (client.request_len >= MAX_REQUEST) return false;
+        ssize_t got = recv(client.fd, client.request + client.request_len, MAX_REQUEST - client.request_len, 0);
+        if (got == 0) return false;
+        if (got < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        client.request_len += got;
+    }
+    client.request[client.request_len] = '\0';
+    if (!strstr(client.request, "\r\n\r\n")) return client.request_len < MAX_REQUEST;
+
+    PrepareResponse(client);
+    return WriteResponse(client);
+}
+
+void MetricsServer::PrepareResponse(Client& client) {
+    // Request line: METHOD SP PATH SP VERSION
+    char method[8] = "", path[64] = "", version[16] = "";
+    sscanf(client.request, "%7s %63s %15s", method, path, version);
+    char* end = strstr(client.request, "\r\n\r\n");
+    *end = '\0';
+    client.close_after = strcmp(version, "HTTP/1.1") != 0 || strcasestr(client.request, "\nConnection: close");
+    *end = '\r';
+
+    bool head = strcmp(method, "HEAD") == 0;
+    const char* status = "200 OK";
+    const char* content_type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    client.body.clear();
+    if (!head && strcmp(method, "GET") != 0) {
+        status = "405 Method Not Allowed";
+        content_type = "text/plain";
+        AppendText(client.body, "Method Not Allowed\n");
+        client.close_after = true;
+    } else if (strcmp(path, "/metrics") != 0 && strncmp(path, "/metrics?", 9) != 0) {
+        status = "404 Not Found";
+        content_type = "text/plain";
+        AppendText(client.body, "Not Found\n");
+    } else {
+        const MonitorSnapshot* snapshot = collector.AcquireSnapshot();
+        if (snapshot) RenderMetrics(*snapshot, client.body);
+        collector.ReleaseSnapshot(snapshot);
+    }
+
+    client.header_len = snprintf(client.header, sizeof(client.header),
+                                 "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n%s\r\n", status,
+                                 content_type, client.body.size(), client.close_after ? "Connection: close\r\n" : "");
+    if (head) client.body.clear();
+    client.sent = 0;
+    client.responding = true;
+
+    // Keep anything pipelined after this request
+    size_t consumed = (end + 4) - client.request;
+    memmove(client.request, client.request + consumed, client.request_len - consumed);
+    client.request_len -= consumed;
+    client.request[client.request_len] = '\0';
+}
+
+bool MetricsServer::WriteResponse(Client& client) {
+    while (client.responding) {
+        size_t total = client.header_len + client.body.size();
+        while (client.sent < total) {
+            iovec parts[2];
+            int count = 0;
+            if (client.sent < client.header_len) {
+                parts[count++] = {client.header + client.sent, client.header_len - client.sent};
+            }
+            size_t body_offset = client.sent > client.header_len ? client.sent - client.header_len : 0;
+            if (body_offset < client.body.size()) {
+                parts[count++] = {client.body.data() + body_offset, client.body.size() - body_offset};
+            }
+
+            msghdr message = {};
+            message.msg_iov = parts;
+            message.msg_iovlen = count;
+            ssize_t written = sendmsg(client.fd, &message, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+                if (errno == EINTR) continue;
+                return false;
+            }
+            client.sent += written;
+        }
+
+        client.responding = false;
+        if (client.close_after) return false;
+        // A pipelined request may already be waiting
+        if (strstr(client.request, "\r\n\r\n")) PrepareResponse(client);
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,411 @@
+#include "header.h"
+
+// Per-collector microbenchmarks: ns, allocations and syscalls per call of
+// each collector and of the render-side helpers, written as JSON so runs
+// on different commits can be compared with --compare
+
+#ifndef _WIN32
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <new>
+
+SystemMonitor g_monitor;
+bool g_running = true;
+
+// Counted on every thread, so worker pool shards are included
+static std::atomic<uint64_t> g_allocations{0};
+static std::atomic<uint64_t> g_allocated_bytes{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* block = malloc(size ? size : 1)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept { free(block); }
+void operator delete[](void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+void operator delete[](void* block, size_t) noexcept { free(block); }
+
+// ImGui allocates through its own hooks (malloc by default), not new
+static void* CountedImGuiAlloc(size_t size, void*) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size);
+}
+
+static void CountedImGuiFree(void* block, void*) { free(block); }
+
+// Counts syscall entries of this process with the raw_syscalls:sys_enter
+// tracepoint; threads started after Open() are included. Without perf
+// access it falls back to the read/write calls in /proc/self/io.
+class SyscallCounter {
+private:
+    int perf_fd = -1;
+
+    static uint64_t ReadProcIO() {
+        std::ifstream io("/proc/self/io");
+        std::string key;
+        uint64_t value, total = 0;
+        while (io >> key >> value) {
+            if (key == "syscr:" || key == "syscw:") total += value;
+        }
+        return total;
+    }
+
+public:
+    const char* source = "none";
+
+    void Open() {
+        const char* id_paths[] = {"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+                                  "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id"};
+        for (const char* path : id_paths) {
+            std::ifstream id_file(path);
+            uint64_t id;
+            if (!(id_file >> id)) continue;
+            perf_event_attr attr = {};
+            attr.type = PERF_TYPE_TRACEPOINT;
+            attr.size = sizeof(attr);
+            attr.config = id;
+            attr.inherit = 1;
+            perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+            if (perf_fd >= 0) {
+                source = "perf";
+                return;
+            }
+        }
+        if (std::ifstream("/proc/self/io")) source = "proc-io";
+    }
+
+    uint64_t Read() const {
+        uint64_t count = 0;
+        if (perf_fd >= 0) {
+            if (read(perf_fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) return 0;
+            return count;
+        }
+        return strcmp(source, "proc-io") == 0 ? ReadProcIO() : 0;
+    }
+};
+
+struct BenchResult {
+    std::string name;
+    double ns_per_op = 0.0;
+    double allocs_per_op = 0.0;
+    double bytes_per_op = 0.0;
+    double syscalls_per_op = 0.0;
+};
+
+static BenchResult RunCase(const char* name, int iterations, const SyscallCounter& syscalls,
+                           const std::function<void()>& op) {
+    // Warm caches and first-call setup (open fds, buffers) out of the measurement
+    for (int i = 0; i < 3; ++i) op();
+
+    // The proc-io counter allocates, so read it before the allocation baseline
+    uint64_t calls = syscalls.Read();
+    uint64_t allocs = g_allocations.load();
+    uint64_t bytes = g_allocated_bytes.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) op();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    // Same order at the end, and before anything below allocates (a long name does)
+    allocs = g_allocations.load() - allocs;
+    bytes = g_allocated_bytes.load() - bytes;
+    calls = syscalls.Read() - calls;
+
+    BenchResult result;
+    result.name = name;
+    result.ns_per_op = ns / iterations;
+    result.allocs_per_op = (double)allocs / iterations;
+    result.bytes_per_op = (double)bytes / iterations;
+    // Minus the one read() of the counter itself
+    result.syscalls_per_op = std::max(0.0, (double)(calls - 1) / iterations);
+    return result;
+}
+
+static void WriteJSON(FILE* out, const std::string& label, int iterations, const char* syscall_source,
+                      const std::vector<BenchResult>& results) {
+    fprintf(out, "{\n  \"label\": \"%s\",\n  \"iterations\": %d,\n  \"syscall_counter\": \"%s\",\n  \"results\": [\n",
+            label.c_str(), iterations, syscall_source);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        fprintf(out,
+                "    {\"name\": \"%s\", \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, \"bytes_per_op\": %.1f, "
+                "\"syscalls_per_op\": %.2f}%s\n",
+                r.name.c_str(), r.ns_per_op, r.allocs_per_op, r.bytes_per_op, r.syscalls_per_op,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+// Reads results back from a file written by WriteJSON (one result per line)
+static std::vector<BenchResult> ReadJSON(const std::string& path) {
+    std::vector<BenchResult> results;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        char name[128];
+        BenchResult r;
+        if (sscanf(line.c_str(),
+                   " {\"name\": \"%127[^\"]\", \"ns_per_op\": %lf, \"allocs_per_op\": %lf, \"bytes_per_op\": %lf, "
+                   "\"syscalls_per_op\": %lf",
+                   name, &r.ns_per_op, &r.allocs_per_op, &r.bytes_per_op, &r.syscalls_per_op) == 5) {
+            r.name = name;
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+// Timing noise is tolerated up to threshold; any extra allocation or
+// syscall per op counts as a regression
+static int Compare(const std::vector<BenchResult>& baseline, const std::vector<BenchResult>& results,
+                   double threshold) {
+    int regressions = 0;
+    printf("\n%-32s %12s %12s %8s\n", "compared to baseline", "ns/op", "allocs/op", "sys/op");
+    for (const BenchResult& r : results) {
+        auto base = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& b) { return b.name == r.name; });
+        if (base == baseline.end()) {
+            printf("%-32s %12s\n", r.name.c_str(), "new");
+            continue;
+        }
+        double time_change = base->ns_per_op > 0 ? r.ns_per_op / base->ns_per_op - 1.0 : 0.0;
+        bool regressed = time_change > threshold || r.allocs_per_op > base->allocs_per_op + 0.5 ||
+                         r.syscalls_per_op > base->syscalls_per_op + 0.5;
+        printf("%-32s %+11.1f%% %+12.2f %+8.2f%s\n", r.name.c_str(), time_change * 100.0,
+               r.allocs_per_op - base->allocs_per_op, r.syscalls_per_op - base->syscalls_per_op,
+               regressed ? "  REGRESSION" : "");
+        if (regressed) regressions++;
+    }
+    return regressions;
+}
+
+static void FillProcessRows(MonitorSnapshot& snapshot, int count) {
+    static const char* names[] = {"systemd", "kworker/0:1", "bash", "sshd", "Xorg", "firefox", "chrome", "python3"};
+    snapshot.processes.resize(count);
+    for (int i = 0; i < count; ++i) {
+        ProcessInfo& proc = snapshot.processes[i];
+        proc.pid = 1 + i * 3;
+        proc.name = std::string(names[i % 8]) + "-" + std::to_string(i % 97);
+        proc.state = i % 5 == 0 ? "R" : "S";
+        proc.cpu_usage = (float)((i * 7919) % 10007) / 100.0f;
+        proc.memory_usage = (float)((i * 104729) % 1009) / 100.0f;
+        proc.alive = true;
+    }
+    snapshot.membership_version = 1;
+    FormatProcessText(snapshot);
+}
+
+static void PrintUsage(const char* program) {
+    printf("Usage: %s [--iterations N] [--rows N] [--root DIR] [--json PATH] [--label TEXT] [--compare BASELINE]\n"
+           "          [--threshold PCT]\n"
+           "  --iterations  calls per collector (default 200; helpers run 100x as many)\n"
+           "  --rows        process table rows for the sort and filter cases (default 40000)\n"
+           "  --root        collect from DIR/proc and DIR/sys, e.g. a tree from sysmon-gen-proctree\n"
+           "  --json        write results as JSON to PATH (- for stdout)\n"
+           "  --compare     exit non-zero when a case is slower than BASELINE by more than\n"
+           "                --threshold percent (default 20), or allocates or syscalls more\n",
+           program);
+}
+
+int main(int argc, char** argv) {
+    int iterations = 200;
+    int rows = 40000;
+    double threshold = 20.0;
+    std::string json_path, label, baseline_path;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--iterations") == 0 && has_value) iterations = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--rows") == 0 && has_value) rows = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--root") == 0 && has_value) {
+            std::string root = argv[++i];
+            SetSystemRoots(root + "/proc", root + "/sys");
+        }
+        else if (strcmp(argv[i], "--json") == 0 && has_value) json_path = argv[++i];
+        else if (strcmp(argv[i], "--label") == 0 && has_value) label = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && has_value) baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && has_value) threshold = atof(argv[++i]);
+        else {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // Before any manager exists, so their worker threads inherit the counter
+    SyscallCounter syscalls;
+    syscalls.Open();
+
+    SystemManager system_manager;
+    system_manager.Initialize();
+    SystemInfo memory_info;
+    MemoryManager memory_manager(&memory_info);
+    NetworkManager network_manager;
+
+    std::vector<BenchResult> results;
+    auto run = [&](const char* name, int count, const std::function<void()>& op) {
+        results.push_back(RunCase(name, count, syscalls, op));
+        const BenchResult& r = results.back();
+        fprintf(stderr, "%-32s %12.1f ns/op %8.2f allocs/op %10.1f B/op %8.2f syscalls/op\n", name, r.ns_per_op,
+                r.allocs_per_op, r.bytes_per_op, r.syscalls_per_op);
+    };
+
+    // Collectors, against the live /proc and /sys unless --root is given
+    run("UpdateCPUUsage", iterations, [&] { system_manager.UpdateCPUUsage(); });
+    run("UpdateThermalInfo", iterations, [&] { system_manager.UpdateThermalInfo(); });
+    run("UpdateMemoryInfo", iterations, [&] { memory_manager.UpdateMemoryInfo(); });
+    run("UpdateProcesses", iterations, [&] { memory_manager.UpdateProcesses(); });
+    run("UpdateDiskInfo", iterations, [&] { memory_manager.UpdateDiskInfo(); });
+    run("UpdateNetworkInterfacesLinux", iterations, [&] { network_manager.UpdateNetworkInterfacesLinux(); });
+    run("CalculateNetworkRates", iterations, [&] { network_manager.CalculateNetworkRates(); });
+
+    // Cell formatting, as the collectors fill the snapshot text
+    MemoryView memory_view(memory_manager);
+    NetworkView network_view;
+    uint64_t sizes[64];
+    for (int i = 0; i < 64; ++i) sizes[i] = (1ull << (i % 48)) + (uint64_t)i * 977;
+    int helper_iterations = iterations * 100;
+    int next = 0;
+    std::vector<char> bytes_text;
+    bytes_text.reserve(64);
+    run("AppendBytes", helper_iterations, [&] {
+        bytes_text.clear();
+        AppendBytes(bytes_text, sizes[next++ & 63]);
+    });
+    TextArena rate_text;
+    run("TextArena::AddRate", helper_iterations, [&] {
+        rate_text.Clear();
+        rate_text.AddRate(sizes[next++ & 63]);
+    });
+
+    // The timing wrapped around every collector and render phase
+    static LatencyHistogram latency;
+    run("ScopedLatency", helper_iterations, [&] { ScopedLatency timer(latency); });
+
+    MonitorSnapshot table;
+    FillProcessRows(table, rows);
+    memory_view.RefreshDisplayOrder(table);
+    ImGuiTableColumnSortSpecs column_specs[2] = {};
+    column_specs[0].ColumnIndex = 3;    // CPU, descending
+    column_specs[0].SortDirection = ImGuiSortDirection_Descending;
+    column_specs[1].ColumnIndex = 1;    // Name, ascending
+    column_specs[1].SortDirection = ImGuiSortDirection_Ascending;
+    ImGuiTableSortSpecs sort_specs[2] = {};
+    for (int s = 0; s < 2; ++s) {
+        sort_specs[s].Specs = &column_specs[s];
+        sort_specs[s].SpecsCount = 1;
+    }
+    int table_iterations = std::max(1, iterations / 10);
+    // Alternating the column keeps every sort from starting out sorted
+    run("ProcessTable::Sort", table_iterations,
+        [&] { memory_view.SortDisplayOrder(table.processes, &sort_specs[next++ & 1]); });
+    // A tick's worth of change: 1% of the rows get new CPU values
+    memory_view.SortDisplayOrder(table.processes, &sort_specs[0]);
+    uint32_t seed = 1;
+    run("ProcessTable::Resort", table_iterations, [&] {
+        for (int i = 0; i < rows / 100; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            table.processes[seed % rows].cpu_usage = (float)(seed >> 20) / 100.0f;
+        }
+        memory_view.SortDisplayOrder(table.processes, &sort_specs[0], true);
+    });
+    // An unrelated query rescans the cached lowercase text of every row
+    size_t matches = 0;
+    const std::string rescans[2] = {"fire", "kwork"};
+    run("ProcessTable::Filter", table_iterations,
+        [&] { matches = memory_view.FilterDisplayOrder(table, rescans[next++ & 1]).size(); });
+    // Typing one more character narrows the cached index; changing the query rebuilds it
+    const std::string queries[2] = {"fi", "fire"};
+    run("ProcessTable::FilterIndex", table_iterations,
+        [&] { matches = memory_view.FilterDisplayOrder(table, queries[next++ & 1]).size(); });
+
+    // Collector-side text of one tick of the process table
+    run("FormatProcessText", table_iterations, [&] { FormatProcessText(table); });
+
+    // Headless frames of the process and network views over a filled snapshot;
+    // once warmed up they should not allocate at all
+    ImGui::SetAllocatorFunctions(CountedImGuiAlloc, CountedImGuiFree);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 800);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    MonitorSnapshot frame;
+    frame.system_info.total_memory = 16ull << 30;
+    frame.system_info.used_memory = 5ull << 30;
+    frame.system_info.total_swap = 4ull << 30;
+    frame.system_info.total_disk = 512ull << 30;
+    frame.system_info.used_disk = 200ull << 30;
+    frame.network_interfaces.resize(8);
+    for (int i = 0; i < 8; ++i) {
+        NetworkInterface& iface = frame.network_interfaces[i];
+        iface.name = "eth" + std::to_string(i);
+        iface.ipv4 = "10.0.0." + std::to_string(i + 1);
+        iface.rx_bytes = 123456789ull * (i + 1);
+        iface.tx_bytes = 98765432ull * (i + 1);
+        iface.rx_rate = 1000ull << i;
+        iface.tx_rate = 700ull << i;
+    }
+    FillProcessRows(frame, rows);
+    frame.versions[COLLECT_PROCESSES] = 1;
+    FormatSystemText(frame);
+    FormatNetworkText(frame);
+    MemoryView frame_view(memory_manager);
+    auto render_frame = [&] {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Monitor");
+        frame_view.RenderMemoryAndProcesses(frame);
+        network_view.RenderNetworkInfo(frame);
+        network_view.RenderNetworkStatistics(frame);
+        ImGui::End();
+        ImGui::Render();
+    };
+    run("RenderFrame", iterations, render_frame);
+    // A frame after each tick: 1% of the rows change CPU, so the table re-sorts
+    run("RenderFrame::NewTick", iterations, [&] {
+        for (int i = 0; i < rows / 100; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            frame.processes[seed % rows].cpu_usage = (float)(seed >> 20) / 100.0f;
+        }
+        frame.versions[COLLECT_PROCESSES]++;
+        render_frame();
+    });
+    ImGui::DestroyContext();
+
+    if (!json_path.empty()) {
+        FILE* out = json_path == "-" ? stdout : fopen(json_path.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", json_path.c_str());
+            return 1;
+        }
+        WriteJSON(out, label, iterations, syscalls.source, results);
+        if (out != stdout) fclose(out);
+    }
+
+    if (!baseline_path.empty()) {
+        std::vector<BenchResult> baseline = ReadJSON(baseline_path);
+        if (baseline.empty()) {
+            fprintf(stderr, "no results in %s\n", baseline_path.c_str());
+            return 1;
+        }
+        return Compare(baseline, results, threshold / 100.0) > 0 ? 2 : 0;
+    }
+    return 0;
+}
+#else
+SystemMonitor g_monitor;
+bool g_running = true;
+
+int main() {
+    printf("Microbenchmarks are only available on Linux\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,244 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <string.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+
+// RouteNetlink Implementation
+RouteNetlink::~RouteNetlink() {
+    Close();
+}
+
+bool RouteNetlink::Open() {
+    if (sock >= 0) return true;
+
+    sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (sock < 0) return false;
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        Close();
+        return false;
+    }
+
+    buffer.resize(64 * 1024);
+    return true;
+}
+
+void RouteNetlink::Close() {
+    if (sock >= 0) {
+        close(sock);
+        sock = -1;
+    }
+    if (events_sock >= 0) {
+        close(events_sock);
+        events_sock = -1;
+    }
+}
+
+bool RouteNetlink::Subscribe() {
+    if (events_sock >= 0) return true;
+
+    events_sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (events_sock < 0) return false;
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+    if (bind(events_sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(events_sock);
+        events_sock = -1;
+        return false;
+    }
+    return true;
+}
+
+bool RouteNetlink::PollEvents(std::vector<int>& changed_links, bool& addresses_changed) {
+    if (events_sock < 0) return false;
+    if (buffer.size() < 64 * 1024) buffer.resize(64 * 1024);
+
+    while (true) {
+        ssize_t len = recv(events_sock, buffer.data(), buffer.size(), 0);
+        if (len < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            // ENOBUFS: the queue overflowed and notifications were dropped
+            return false;
+        }
+        if (len == 0) return true;
+
+        int remaining = (int)len;
+        for (struct nlmsghdr* header = (struct nlmsghdr*)buffer.data(); NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            switch (header->nlmsg_type) {
+                case RTM_NEWLINK:
+                case RTM_DELLINK:
+                    changed_links.push_back(((struct ifinfomsg*)NLMSG_DATA(header))->ifi_index);
+                    break;
+                case RTM_NEWADDR:
+                case RTM_DELADDR:
+                    addresses_changed = true;
+                    break;
+            }
+        }
+    }
+}
+
+bool RouteNetlink::SendDump(int type, int family) {
+    struct {
+        struct nlmsghdr header;
+        struct rtgenmsg body;
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtgenmsg));
+    request.header.nlmsg_type = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = ++seq;
+    request.body.rtgen_family = family;
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    return sendto(sock, &request, request.header.nlmsg_len, 0, (struct sockaddr*)&kernel, sizeof(kernel)) >= 0;
+}
+
+// Calls on_message for every message of the current dump until NLMSG_DONE
+template <typename Fn>
+bool RouteNetlink::ReceiveDump(Fn on_message) {
+    while (true) {
+        ssize_t len = recv(sock, buffer.data(), buffer.size(), 0);
+        if (len < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (len == 0) return false;
+
+        int remaining = (int)len;
+        for (struct nlmsghdr* header = (struct nlmsghdr*)buffer.data(); NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_seq != seq) continue;     // Stale reply from an interrupted dump
+            if (header->nlmsg_type == NLMSG_DONE) return true;
+            if (header->nlmsg_type == NLMSG_ERROR) return false;
+            on_message(header);
+        }
+    }
+}
+
+bool RouteNetlink::DumpLinks(std::vector<NetworkInterface>& ifaces) {
+    if (sock < 0 || !SendDump(RTM_GETLINK, AF_UNSPEC)) return false;
+
+    size_t count = 0;
+    std::fill(index_to_position.begin(), index_to_position.end(), -1);
+
+    bool ok = ReceiveDump([&](struct nlmsghdr* header) {
+        if (header->nlmsg_type != RTM_NEWLINK) return;
+        struct ifinfomsg* info = (struct ifinfomsg*)NLMSG_DATA(header);
+
+        if (count == ifaces.size()) ifaces.emplace_back();
+        NetworkInterface& iface = ifaces[count];
+
+        // Reset everything but the string buffers
+        iface.name.clear();
+        iface.description.clear();
+        iface.ipv4.clear();
+        iface.ipv6.clear();
+        iface.mac_address.clear();
+        iface.ifindex = info->ifi_index;
+        iface.type = info->ifi_type;
+        iface.operational_status = (info->ifi_flags & IFF_UP) && (info->ifi_flags & IFF_RUNNING);
+        iface.speed_mbps = 0;
+        iface.rx_rate = iface.tx_rate = iface.rx_packet_rate = iface.tx_packet_rate = 0;
+
+        bool has_stats = false;
+        struct rtnl_link_stats64 stats;
+        int attr_len = IFLA_PAYLOAD(header);
+        for (struct rtattr* attr = IFLA_RTA(info); RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+            switch (attr->rta_type) {
+                case IFLA_IFNAME:
+                    iface.name.assign((const char*)RTA_DATA(attr), strnlen((const char*)RTA_DATA(attr), RTA_PAYLOAD(attr)));
+                    break;
+                case IFLA_ADDRESS: {
+                    const unsigned char* bytes = (const unsigned char*)RTA_DATA(attr);
+                    char mac[3 * 32];
+                    size_t n = std::min((size_t)RTA_PAYLOAD(attr), (size_t)32);
+                    for (size_t i = 0; i < n; ++i) {
+                        snprintf(mac + i * 3, 4, i + 1 < n ? "%02x:" : "%02x", bytes[i]);
+                    }
+                    iface.mac_address.assign(mac, n > 0 ? n * 3 - 1 : 0);
+                    break;
+                }
+                case IFLA_STATS64:
+                    // The payload is only 4-byte aligned
+                    memcpy(&stats, RTA_DATA(attr), std::min(sizeof(stats), (size_t)RTA_PAYLOAD(attr)));
+                    has_stats = true;
+                    break;
+            }
+        }
+        if (!has_stats) memset(&stats, 0, sizeof(stats));
+
+        // Same folding of the detailed counters as /proc/net/dev
+        iface.rx_bytes = stats.rx_bytes;
+        iface.rx_packets = stats.rx_packets;
+        iface.rx_errs = stats.rx_errors;
+        iface.rx_drop = stats.rx_dropped + stats.rx_missed_errors;
+        iface.rx_fifo = stats.rx_fifo_errors;
+        iface.rx_frame = stats.rx_length_errors + stats.rx_over_errors + stats.rx_crc_errors + stats.rx_frame_errors;
+        iface.rx_compressed = stats.rx_compressed;
+        iface.rx_multicast = stats.multicast;
+        iface.tx_bytes = stats.tx_bytes;
+        iface.tx_packets = stats.tx_packets;
+        iface.tx_errs = stats.tx_errors;
+        iface.tx_drop = stats.tx_dropped;
+        iface.tx_fifo = stats.tx_fifo_errors;
+        iface.tx_colls = stats.collisions;
+        iface.tx_carrier = stats.tx_carrier_errors + stats.tx_aborted_errors +
+                           stats.tx_window_errors + stats.tx_heartbeat_errors;
+        iface.tx_compressed = stats.tx_compressed;
+
+        if (iface.ifindex >= (int)index_to_position.size()) {
+            index_to_position.resize(iface.ifindex + 1, -1);
+        }
+        index_to_position[iface.ifindex] = (int)count;
+        count++;
+    });
+
+    ifaces.resize(count);
+    return ok;
+}
+
+bool RouteNetlink::DumpAddresses(std::vector<NetworkInterface>& ifaces) {
+    if (sock < 0 || !SendDump(RTM_GETADDR, AF_UNSPEC)) return false;
+
+    return ReceiveDump([&](struct nlmsghdr* header) {
+        if (header->nlmsg_type != RTM_NEWADDR) return;
+        struct ifaddrmsg* info = (struct ifaddrmsg*)NLMSG_DATA(header);
+        if ((int)info->ifa_index >= (int)index_to_position.size()) return;
+        int position = index_to_position[info->ifa_index];
+        if (position < 0) return;
+        NetworkInterface& iface = ifaces[position];
+
+        // IFA_LOCAL is the interface's own address on point-to-point links
+        const void* address = nullptr;
+        int attr_len = IFA_PAYLOAD(header);
+        for (struct rtattr* attr = IFA_RTA(info); RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+            if (attr->rta_type == IFA_LOCAL || (attr->rta_type == IFA_ADDRESS && !address)) {
+                address = RTA_DATA(attr);
+            }
+        }
+        if (!address) return;
+
+        // The first IPv4 address is the primary one; prefer a global IPv6 address
+        char text[INET6_ADDRSTRLEN];
+        if (info->ifa_family == AF_INET && iface.ipv4.empty()) {
+            if (inet_ntop(AF_INET, address, text, sizeof(text))) iface.ipv4 = text;
+        } else if (info->ifa_family == AF_INET6 && (iface.ipv6.empty() || info->ifa_scope == RT_SCOPE_UNIVERSE)) {
+            if (inet_ntop(AF_INET6, address, text, sizeof(text))) iface.ipv6 = text;
+        }
+    });
+}
+#endif
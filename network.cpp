@@ -1,9 +1,18 @@
-#include "header.h"
+#include "collector.h"
+
+#ifndef _WIN32
+#include <linux/if_packet.h>
+#endif
 
 // NetworkManager Implementation
 NetworkManager::NetworkManager() {
     // Initialize previous values for rate calculation
     previous_update_time = std::chrono::steady_clock::now();
+#ifndef _WIN32
+    net_dev_source = sources.Register(ProcRoot() + "/net/dev");
+    // rtnetlink lists the host's links, not those of a synthetic tree
+    netlink_failed = !UsingHostRoots();
+#endif
 }
 
 void NetworkManager::Update() {
@@ -71,393 +80,264 @@ void NetworkManager::UpdateNetworkInterfacesWindows() {
 }
 #else
 void NetworkManager::UpdateNetworkInterfacesLinux() {
-    network_interfaces.clear();
-    
-    // Read from /proc/net/dev
-    std::ifstream net_dev("/proc/net/dev");
-    std::string line;
-    
-    // Skip header lines
-    std::getline(net_dev, line);
-    std::getline(net_dev, line);
-    
-    while (std::getline(net_dev, line)) {
-        std::istringstream iss(line);
-        std::string iface_name;
-        
-        if (std::getline(iss, iface_name, ':')) {
-            // Trim whitespace
-            iface_name.erase(0, iface_name.find_first_not_of(" \t"));
-            iface_name.erase(iface_name.find_last_not_of(" \t") + 1);
-            
-            NetworkInterface iface;
-            iface.name = iface_name;
-            
-            // Parse network statistics
-            iss >> iface.rx_bytes >> iface.rx_packets >> iface.rx_errs >> iface.rx_drop
-                >> iface.rx_fifo >> iface.rx_frame >> iface.rx_compressed >> iface.rx_multicast
-                >> iface.tx_bytes >> iface.tx_packets >> iface.tx_errs >> iface.tx_drop
-                >> iface.tx_fifo >> iface.tx_colls >> iface.tx_carrier >> iface.tx_compressed;
-            
-            // Get IP address and additional info
-            GetInterfaceDetails(iface);
-            
-            network_interfaces.push_back(iface);
-        }
+    // Prefer rtnetlink; fall back to /proc/net/dev for good if it ever fails
+    if (!netlink_failed) {
+        if (UpdateNetworkInterfacesNetlink()) return;
+        netlink_failed = true;
+        rtnl.Close();
     }
+    UpdateNetworkInterfacesProcfs();
 }
 
-void NetworkManager::GetInterfaceDetails(NetworkInterface& iface) {
-    // Get IP address using getifaddrs
-    struct ifaddrs *ifaddr, *ifa;
-    if (getifaddrs(&ifaddr) != -1) {
-        for (ifa = ifaddr; ifa != NULL; ifa = ifa->ifa_next) {
-            if (ifa->ifa_addr && std::string(ifa->ifa_name) == iface.name) {
-                if (ifa->ifa_addr->sa_family == AF_INET) {
-                    struct sockaddr_in* addr_in = (struct sockaddr_in*)ifa->ifa_addr;
-                    iface.ipv4 = inet_ntoa(addr_in->sin_addr);
-                } else if (ifa->ifa_addr->sa_family == AF_INET6) {
-                    struct sockaddr_in6* addr_in6 = (struct sockaddr_in6*)ifa->ifa_addr;
-                    char ipv6_str[INET6_ADDRSTRLEN];
-                    inet_ntop(AF_INET6, &(addr_in6->sin6_addr), ipv6_str, INET6_ADDRSTRLEN);
-                    iface.ipv6 = ipv6_str;
-                }
-                
-                // Check if interface is up
-                iface.operational_status = (ifa->ifa_flags & IFF_UP) && (ifa->ifa_flags & IFF_RUNNING);
-            }
-        }
-        freeifaddrs(ifaddr);
-    }
-    
-    // Get interface type and additional details
-    std::string sys_path = "/sys/class/net/" + iface.name + "/type";
-    std::ifstream type_file(sys_path);
-    if (type_file.is_open()) {
-        type_file >> iface.type;
-    }
-    
-    // Get interface speed
-    sys_path = "/sys/class/net/" + iface.name + "/speed";
-    std::ifstream speed_file(sys_path);
-    if (speed_file.is_open()) {
-        speed_file >> iface.speed_mbps;
-    }
-    
-    // Get MAC address
-    sys_path = "/sys/class/net/" + iface.name + "/address";
-    std::ifstream mac_file(sys_path);
-    if (mac_file.is_open()) {
-        std::getline(mac_file, iface.mac_address);
+// FNV-1a over the interface set; a changed set forces an attribute refresh
+static uint64_t HashInterfaceSet(const std::vector<NetworkInterface>& ifaces) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const auto& iface : ifaces) {
+        for (char c : iface.name) hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+        hash = (hash ^ (uint64_t)(uint32_t)iface.ifindex) * 1099511628211ULL;
     }
+    return hash;
 }
-#endif
 
-void NetworkManager::CalculateNetworkRates() {
-    auto current_time = std::chrono::steady_clock::now();
-    auto time_diff = std::chrono::duration_cast<std::chrono::seconds>(current_time - previous_update_time).count();
-    
-    if (time_diff > 0 && !previous_interfaces.empty()) {
-        for (auto& current_iface : network_interfaces) {
-            // Find matching previous interface
-            auto prev_it = std::find_if(previous_interfaces.begin(), previous_interfaces.end(),
-                [&current_iface](const NetworkInterface& prev) {
-                    return prev.name == current_iface.name;
-                });
-            
-            if (prev_it != previous_interfaces.end()) {
-                // Calculate rates (bytes per second)
-                current_iface.rx_rate = (current_iface.rx_bytes - prev_it->rx_bytes) / time_diff;
-                current_iface.tx_rate = (current_iface.tx_bytes - prev_it->tx_bytes) / time_diff;
-                
-                // Calculate packet rates
-                current_iface.rx_packet_rate = (current_iface.rx_packets - prev_it->rx_packets) / time_diff;
-                current_iface.tx_packet_rate = (current_iface.tx_packets - prev_it->tx_packets) / time_diff;
-            }
-        }
-    }
-    
-    previous_interfaces = network_interfaces;
-    previous_update_time = current_time;
-}
+bool NetworkManager::AttributesExpired(uint64_t generation) {
+    bool expired = attributes_dirty || generation != interface_generation;
 
-std::string NetworkManager::FormatBytes(uint64_t bytes) {
-    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
-    int unit = 0;
-    double value = (double)bytes;
-    
-    while (value >= 1024.0 && unit < 4) {
-        value /= 1024.0;
-        unit++;
+    // Without link notifications fall back to a periodic refresh
+    if (!rtnl.IsSubscribed() && --ticks_until_refresh <= 0) expired = true;
+
+    if (expired) {
+        attributes_dirty = false;
+        interface_generation = generation;
+        ticks_until_refresh = ATTRIBUTE_REFRESH_TICKS;
     }
-    
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "%.2f %s", value, units[unit]);
-    return std::string(buffer);
+    return expired;
 }
 
-std::string NetworkManager::FormatRate(uint64_t bytes_per_sec) {
-    return FormatBytes(bytes_per_sec) + "/s";
+uint32_t NetworkManager::ReadLinkSpeed(const std::string& name) {
+    // Reports -1 or fails with EINVAL for links without a speed
+    std::ifstream speed_file(SysRoot() + "/class/net/" + name + "/speed");
+    int value;
+    if (speed_file >> value && value > 0) return (uint32_t)value;
+    return 0;
 }
 
-void NetworkManager::RenderNetwork() {}
+bool NetworkManager::UpdateNetworkInterfacesNetlink() {
+    if (!rtnl.Open()) return false;
+    if (!rtnl.DumpLinks(network_interfaces)) return false;
 
-void NetworkManager::RenderNetworkInfo() {
-    // Network interface summary
-    ImGui::Text("Network Interfaces: %zu", network_interfaces.size());
-    ImGui::Separator();
-    
-    // Interface overview
-    for (const auto& iface : network_interfaces) {
-        ImGui::Text("Interface: %s", iface.name.c_str());
-        ImGui::SameLine();
-        if (iface.operational_status) {
-            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "[UP]");
-        } else {
-            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "[DOWN]");
-        }
-        
-        ImGui::Text("  IPv4: %s", iface.ipv4.empty() ? "N/A" : iface.ipv4.c_str());
-        if (!iface.ipv6.empty()) {
-            ImGui::Text("  IPv6: %s", iface.ipv6.c_str());
+    // Link events make the speed stale; any event re-dumps the addresses
+    if (rtnl.IsSubscribed() || rtnl.Subscribe()) {
+        changed_links.clear();
+        bool addresses_changed = false;
+        if (!rtnl.PollEvents(changed_links, addresses_changed)) {
+            link_attributes.clear();
+            attributes_dirty = true;
         }
-        if (!iface.mac_address.empty()) {
-            ImGui::Text("  MAC: %s", iface.mac_address.c_str());
+        for (int ifindex : changed_links) {
+            auto it = link_attributes.find(ifindex);
+            if (it != link_attributes.end()) it->second.has_speed = false;
         }
-        if (iface.speed_mbps > 0) {
-            ImGui::Text("  Speed: %d Mbps", iface.speed_mbps);
-        }
-        
-        // Real-time rates
-        ImGui::Text("  RX Rate: %s", FormatRate(iface.rx_rate).c_str());
-        ImGui::Text("  TX Rate: %s", FormatRate(iface.tx_rate).c_str());
-        
-        ImGui::Separator();
+        if (addresses_changed || !changed_links.empty()) attributes_dirty = true;
     }
-    
-    // Network tables
-    if (ImGui::BeginTabBar("NetworkTabs")) {
-        if (ImGui::BeginTabItem("RX (Receive)")) {
-            RenderNetworkTable(true);
-            ImGui::EndTabItem();
+
+    if (AttributesExpired(HashInterfaceSet(network_interfaces))) {
+        if (!rtnl.DumpAddresses(network_interfaces)) return false;
+
+        // Rebuild the cache so removed interfaces drop out
+        std::unordered_map<int, InterfaceAttributes> refreshed;
+        refreshed.reserve(network_interfaces.size());
+        for (const auto& iface : network_interfaces) {
+            InterfaceAttributes& entry = refreshed[iface.ifindex];
+            auto old = link_attributes.find(iface.ifindex);
+            if (old != link_attributes.end()) entry = std::move(old->second);
+            entry.ipv4 = iface.ipv4;
+            entry.ipv6 = iface.ipv6;
         }
-        
-        if (ImGui::BeginTabItem("TX (Transmit)")) {
-            RenderNetworkTable(false);
-            ImGui::EndTabItem();
+        link_attributes.swap(refreshed);
+    } else {
+        for (auto& iface : network_interfaces) {
+            auto it = link_attributes.find(iface.ifindex);
+            if (it == link_attributes.end()) continue;
+            iface.ipv4 = it->second.ipv4;
+            iface.ipv6 = it->second.ipv6;
         }
-        
-        if (ImGui::BeginTabItem("Statistics")) {
-            RenderNetworkStatistics();
-            ImGui::EndTabItem();
+    }
+
+    // Link speed is not part of rtnetlink, so it comes from sysfs when stale
+    for (auto& iface : network_interfaces) {
+        InterfaceAttributes& entry = link_attributes[iface.ifindex];
+        if (!entry.has_speed) {
+            entry.speed_mbps = ReadLinkSpeed(iface.name);
+            entry.has_speed = true;
         }
-        
-        ImGui::EndTabBar();
+        iface.speed_mbps = entry.speed_mbps;
     }
+    return true;
+}
+
+void NetworkManager::UpdateNetworkInterfacesProcfs() {
+    network_interfaces.clear();
     
-    // Network usage visualization
-    ImGui::Separator();
-    ImGui::Text("Network Usage Visualization:");
+    // Read from /proc/net/dev
+    if (sources.Read(net_dev_source, read_buffer) <= 0) return;
+    
+    // Skip the two header lines
+    const char* line = read_buffer.data();
+    for (int i = 0; i < 2 && line; ++i) {
+        line = strchr(line, '\n');
+        if (line) line++;
+    }
     
-    for (const auto& iface : network_interfaces) {
-        if (iface.name == "lo") continue; // Skip loopback interface
+    while (line && *line) {
+        const char* eol = strchr(line, '\n');
+        const char* colon = (const char*)memchr(line, ':', eol ? eol - line : strlen(line));
+        if (!colon) break;
         
-        float rx_gb = (float)iface.rx_bytes / (1024.0f * 1024.0f * 1024.0f);
-        float tx_gb = (float)iface.tx_bytes / (1024.0f * 1024.0f * 1024.0f);
-        float max_gb = 10.0f; // 10GB scale
+        // Trim whitespace
+        const char* name_start = line;
+        while (name_start < colon && (*name_start == ' ' || *name_start == '\t')) name_start++;
         
-        ImGui::Text("%s:", iface.name.c_str());
-        ImGui::Text("  RX: %s (%s)", FormatBytes(iface.rx_bytes).c_str(), FormatRate(iface.rx_rate).c_str());
-        ImGui::ProgressBar(std::min(rx_gb / max_gb, 1.0f), ImVec2(0, 0));
+        NetworkInterface iface;
+        iface.name.assign(name_start, colon - name_start);
         
-        ImGui::Text("  TX: %s (%s)", FormatBytes(iface.tx_bytes).c_str(), FormatRate(iface.tx_rate).c_str());
-        ImGui::ProgressBar(std::min(tx_gb / max_gb, 1.0f), ImVec2(0, 0));
+        // Parse network statistics
+        uint64_t* fields[] = {
+            &iface.rx_bytes, &iface.rx_packets, &iface.rx_errs, &iface.rx_drop,
+            &iface.rx_fifo, &iface.rx_frame, &iface.rx_compressed, &iface.rx_multicast,
+            &iface.tx_bytes, &iface.tx_packets, &iface.tx_errs, &iface.tx_drop,
+            &iface.tx_fifo, &iface.tx_colls, &iface.tx_carrier, &iface.tx_compressed,
+        };
+        const char* p = colon + 1;
+        for (uint64_t* field : fields) {
+            char* next;
+            *field = strtoull(p, &next, 10);
+            p = next;
+        }
         
-        ImGui::Separator();
+        network_interfaces.push_back(iface);
+        line = eol ? eol + 1 : nullptr;
+    }
+
+    // Addresses, MAC, type and speed come from the attribute cache
+    if (AttributesExpired(HashInterfaceSet(network_interfaces))) {
+        RefreshInterfaceAttributesProcfs();
+    }
+    for (auto& iface : network_interfaces) {
+        auto index = name_to_index.find(iface.name);
+        if (index == name_to_index.end()) continue;
+        const InterfaceAttributes& entry = link_attributes[index->second];
+        iface.ifindex = index->second;
+        iface.ipv4 = entry.ipv4;
+        iface.ipv6 = entry.ipv6;
+        iface.mac_address = entry.mac_address;
+        iface.type = entry.type;
+        iface.operational_status = entry.operational_status;
+        iface.speed_mbps = entry.speed_mbps;
     }
 }
 
-void NetworkManager::RenderNetworkTable(bool is_rx) {
-    if (ImGui::BeginTable(is_rx ? "RXTable" : "TXTable", 8, 
-                         ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
-                         ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
-        
-        ImGui::TableSetupColumn("Interface");
-        ImGui::TableSetupColumn("Bytes");
-        ImGui::TableSetupColumn("Packets");
-        ImGui::TableSetupColumn("Errors");
-        ImGui::TableSetupColumn("Drops");
-        if (is_rx) {
-            ImGui::TableSetupColumn("FIFO");
-            ImGui::TableSetupColumn("Frame");
-            ImGui::TableSetupColumn("Compressed");
-        } else {
-            ImGui::TableSetupColumn("FIFO");
-            ImGui::TableSetupColumn("Colls");
-            ImGui::TableSetupColumn("Carrier");
+void NetworkManager::RefreshInterfaceAttributesProcfs() {
+    name_to_index.clear();
+    link_attributes.clear();
+
+    struct ifaddrs *ifaddr, *ifa;
+    if (getifaddrs(&ifaddr) == -1) return;
+
+    // AF_PACKET entries carry the ifindex, hardware type and MAC address
+    for (ifa = ifaddr; ifa != NULL; ifa = ifa->ifa_next) {
+        if (!ifa->ifa_addr || ifa->ifa_addr->sa_family != AF_PACKET) continue;
+        struct sockaddr_ll* link = (struct sockaddr_ll*)ifa->ifa_addr;
+
+        name_to_index[ifa->ifa_name] = link->sll_ifindex;
+        InterfaceAttributes& entry = link_attributes[link->sll_ifindex];
+        entry.type = link->sll_hatype;
+        entry.operational_status = (ifa->ifa_flags & IFF_UP) && (ifa->ifa_flags & IFF_RUNNING);
+
+        char mac[3 * 8];
+        int n = std::min((int)link->sll_halen, 8);
+        for (int i = 0; i < n; ++i) {
+            snprintf(mac + i * 3, 4, i + 1 < n ? "%02x:" : "%02x", link->sll_addr[i]);
         }
-        ImGui::TableHeadersRow();
-        
-        for (const auto& iface : network_interfaces) {
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", iface.name.c_str());
-            
-            if (is_rx) {
-                ImGui::TableSetColumnIndex(1);
-                ImGui::Text("%s", FormatBytes(iface.rx_bytes).c_str());
-                
-                ImGui::TableSetColumnIndex(2);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_packets);
-                
-                ImGui::TableSetColumnIndex(3);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_errs);
-                
-                ImGui::TableSetColumnIndex(4);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_drop);
-                
-                ImGui::TableSetColumnIndex(5);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_fifo);
-                
-                ImGui::TableSetColumnIndex(6);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_frame);
-                
-                ImGui::TableSetColumnIndex(7);
-                ImGui::Text("%llu", (unsigned long long)iface.rx_compressed);
-            } else {
-                ImGui::TableSetColumnIndex(1);
-                ImGui::Text("%s", FormatBytes(iface.tx_bytes).c_str());
-                
-                ImGui::TableSetColumnIndex(2);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_packets);
-                
-                ImGui::TableSetColumnIndex(3);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_errs);
-                
-                ImGui::TableSetColumnIndex(4);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_drop);
-                
-                ImGui::TableSetColumnIndex(5);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_fifo);
-                
-                ImGui::TableSetColumnIndex(6);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_colls);
-                
-                ImGui::TableSetColumnIndex(7);
-                ImGui::Text("%llu", (unsigned long long)iface.tx_carrier);
+        entry.mac_address.assign(mac, n > 0 ? n * 3 - 1 : 0);
+
+        entry.speed_mbps = ReadLinkSpeed(ifa->ifa_name);
+        entry.has_speed = true;
+    }
+
+    // Same address choice as the netlink path: first IPv4, global IPv6 preferred
+    for (ifa = ifaddr; ifa != NULL; ifa = ifa->ifa_next) {
+        if (!ifa->ifa_addr) continue;
+        auto index = name_to_index.find(ifa->ifa_name);
+        if (index == name_to_index.end()) continue;
+        InterfaceAttributes& entry = link_attributes[index->second];
+
+        char text[INET6_ADDRSTRLEN];
+        if (ifa->ifa_addr->sa_family == AF_INET && entry.ipv4.empty()) {
+            struct sockaddr_in* addr_in = (struct sockaddr_in*)ifa->ifa_addr;
+            if (inet_ntop(AF_INET, &addr_in->sin_addr, text, sizeof(text))) entry.ipv4 = text;
+        } else if (ifa->ifa_addr->sa_family == AF_INET6) {
+            struct sockaddr_in6* addr_in6 = (struct sockaddr_in6*)ifa->ifa_addr;
+            if (entry.ipv6.empty() || !IN6_IS_ADDR_LINKLOCAL(&addr_in6->sin6_addr)) {
+                if (inet_ntop(AF_INET6, &addr_in6->sin6_addr, text, sizeof(text))) entry.ipv6 = text;
             }
         }
-        
-        ImGui::EndTable();
     }
+    freeifaddrs(ifaddr);
 }
+#endif
 
-void NetworkManager::RenderNetworkStatistics() {
-    if (ImGui::BeginTable("NetworkStats", 6, 
-                         ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
-                         ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
-        
-        ImGui::TableSetupColumn("Interface");
-        ImGui::TableSetupColumn("Status");
-        ImGui::TableSetupColumn("Total RX");
-        ImGui::TableSetupColumn("Total TX");
-        ImGui::TableSetupColumn("RX Rate");
-        ImGui::TableSetupColumn("TX Rate");
-        ImGui::TableHeadersRow();
-        
-        for (const auto& iface : network_interfaces) {
-            ImGui::TableNextRow();
-            
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", iface.name.c_str());
-            
-            ImGui::TableSetColumnIndex(1);
-            if (iface.operational_status) {
-                ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "UP");
+const char* NetworkManager::GetBackendName() const {
+#ifdef _WIN32
+    return "IP Helper";
+#else
+    return netlink_failed ? "/proc/net/dev" : "netlink";
+#endif
+}
+
+// Counters reset when an interface is recreated; report 0 rather than a wrapped value
+static uint64_t CounterRate(uint64_t current, uint64_t previous, double seconds) {
+    return current >= previous ? (uint64_t)((current - previous) / seconds) : 0;
+}
+
+void NetworkManager::CalculateNetworkRates() {
+    auto current_time = std::chrono::steady_clock::now();
+    // Fractional seconds: the network collector may run faster than once a second
+    double time_diff = std::chrono::duration<double>(current_time - previous_update_time).count();
+    
+    if (time_diff > 0 && !previous_interfaces.empty()) {
+        for (size_t i = 0; i < network_interfaces.size(); ++i) {
+            NetworkInterface& current_iface = network_interfaces[i];
+
+            // The list order is stable between ticks, so check the same slot first
+            auto prev_it = previous_interfaces.end();
+            if (i < previous_interfaces.size() && previous_interfaces[i].name == current_iface.name) {
+                prev_it = previous_interfaces.begin() + i;
             } else {
-                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "DOWN");
+                prev_it = std::find_if(previous_interfaces.begin(), previous_interfaces.end(),
+                    [&current_iface](const NetworkInterface& prev) {
+                        return prev.name == current_iface.name;
+                    });
             }
             
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%s", FormatBytes(iface.rx_bytes).c_str());
-            
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%s", FormatBytes(iface.tx_bytes).c_str());
-            
-            ImGui::TableSetColumnIndex(4);
-            ImGui::Text("%s", FormatRate(iface.rx_rate).c_str());
-            
-            ImGui::TableSetColumnIndex(5);
-            ImGui::Text("%s", FormatRate(iface.tx_rate).c_str());
-        }
-        
-        ImGui::EndTable();
-    }
-    
-    // Additional statistics
-    ImGui::Separator();
-    ImGui::Text("Network Summary:");
-    
-    uint64_t total_rx = 0, total_tx = 0;
-    uint64_t total_rx_rate = 0, total_tx_rate = 0;
-    int active_interfaces = 0;
-    
-    for (const auto& iface : network_interfaces) {
-        if (iface.name != "lo") { // Skip loopback
-            total_rx += iface.rx_bytes;
-            total_tx += iface.tx_bytes;
-            total_rx_rate += iface.rx_rate;
-            total_tx_rate += iface.tx_rate;
-            if (iface.operational_status) {
-                active_interfaces++;
+            if (prev_it != previous_interfaces.end()) {
+                // Calculate rates (bytes per second)
+                current_iface.rx_rate = CounterRate(current_iface.rx_bytes, prev_it->rx_bytes, time_diff);
+                current_iface.tx_rate = CounterRate(current_iface.tx_bytes, prev_it->tx_bytes, time_diff);
+                
+                // Calculate packet rates
+                current_iface.rx_packet_rate = CounterRate(current_iface.rx_packets, prev_it->rx_packets, time_diff);
+                current_iface.tx_packet_rate = CounterRate(current_iface.tx_packets, prev_it->tx_packets, time_diff);
             }
         }
     }
     
-    ImGui::Text("Active Interfaces: %d", active_interfaces);
-    ImGui::Text("Total Data Received: %s", FormatBytes(total_rx).c_str());
-    ImGui::Text("Total Data Transmitted: %s", FormatBytes(total_tx).c_str());
-    ImGui::Text("Current RX Rate: %s", FormatRate(total_rx_rate).c_str());
-    ImGui::Text("Current TX Rate: %s", FormatRate(total_tx_rate).c_str());
-    
-    // Calculate total traffic
-    uint64_t total_traffic = total_rx + total_tx;
-    ImGui::Text("Total Network Traffic: %s", FormatBytes(total_traffic).c_str());
-    
-    // Show packet statistics
-    ImGui::Separator();
-    ImGui::Text("Packet Statistics:");
-    
-    uint64_t total_rx_packets = 0, total_tx_packets = 0;
-    uint64_t total_rx_errors = 0, total_tx_errors = 0;
-    uint64_t total_rx_drops = 0, total_tx_drops = 0;
-    
-    for (const auto& iface : network_interfaces) {
-        if (iface.name != "lo") { // Skip loopback
-            total_rx_packets += iface.rx_packets;
-            total_tx_packets += iface.tx_packets;
-            total_rx_errors += iface.rx_errs;
-            total_tx_errors += iface.tx_errs;
-            total_rx_drops += iface.rx_drop;
-            total_tx_drops += iface.tx_drop;
-        }
-    }
-    
-    ImGui::Text("Total Packets Received: %llu", (unsigned long long)total_rx_packets);
-    ImGui::Text("Total Packets Transmitted: %llu", (unsigned long long)total_tx_packets);
-    ImGui::Text("Total RX Errors: %llu", (unsigned long long)total_rx_errors);
-    ImGui::Text("Total TX Errors: %llu", (unsigned long long)total_tx_errors);
-    ImGui::Text("Total RX Drops: %llu", (unsigned long long)total_rx_drops);
-    ImGui::Text("Total TX Drops: %llu", (unsigned long long)total_tx_drops);
-    
-    // Calculate error rates
-    if (total_rx_packets > 0) {
-        float rx_error_rate = (float)(total_rx_errors * 100.0 / total_rx_packets);
-        ImGui::Text("RX Error Rate: %.2f%%", rx_error_rate);
-    }
-    
-    if (total_tx_packets > 0) {
-        float tx_error_rate = (float)(total_tx_errors * 100.0 / total_tx_packets);
-        ImGui::Text("TX Error Rate: %.2f%%", tx_error_rate);
-    }
-}
\ No newline at end of file
+    previous_interfaces = network_interfaces;
+    previous_update_time = current_time;
+}
+
+void NetworkManager::WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const {
+    if (!stale[COLLECT_NETWORK]) return;
+    snapshot.network_interfaces = network_interfaces;
+    snapshot.network_backend = GetBackendName();
+    FormatNetworkText(snapshot);
+}
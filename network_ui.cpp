@@ -0,0 +1,232 @@
+#include "header.h"
+
+void NetworkView::RenderNetwork(const MonitorSnapshot& snapshot) {
+    RenderNetworkInfo(snapshot);
+}
+
+void NetworkView::RenderNetworkInfo(const MonitorSnapshot& snapshot) {
+    // Network interface summary
+    ImGui::Text("Network Interfaces: %zu", snapshot.network_interfaces.size());
+    ImGui::SameLine();
+    ImGui::TextDisabled("(source: %s)", snapshot.network_backend);
+    ImGui::Separator();
+    
+    // Interface overview
+    const TextArena& text = snapshot.network_text;
+    for (size_t i = 0; i < snapshot.network_interfaces.size(); ++i) {
+        const auto& iface = snapshot.network_interfaces[i];
+        const InterfaceText& cells = snapshot.interface_cells[i];
+        ImGui::Text("Interface: %s", iface.name.c_str());
+        ImGui::SameLine();
+        if (iface.operational_status) {
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "[UP]");
+        } else {
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "[DOWN]");
+        }
+        
+        ImGui::Text("  IPv4: %s", iface.ipv4.empty() ? "N/A" : iface.ipv4.c_str());
+        if (!iface.ipv6.empty()) {
+            ImGui::Text("  IPv6: %s", iface.ipv6.c_str());
+        }
+        if (!iface.mac_address.empty()) {
+            ImGui::Text("  MAC: %s", iface.mac_address.c_str());
+        }
+        if (iface.speed_mbps > 0) {
+            ImGui::Text("  Speed: %d Mbps", iface.speed_mbps);
+        }
+        
+        // Real-time rates
+        ImGui::Text("  RX Rate: %s", text.Get(cells.rx_rate));
+        ImGui::Text("  TX Rate: %s", text.Get(cells.tx_rate));
+        
+        ImGui::Separator();
+    }
+    
+    // Network tables
+    if (ImGui::BeginTabBar("NetworkTabs")) {
+        if (ImGui::BeginTabItem("RX (Receive)")) {
+            RenderNetworkTable(snapshot, true);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("TX (Transmit)")) {
+            RenderNetworkTable(snapshot, false);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Statistics")) {
+            RenderNetworkStatistics(snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        ImGui::EndTabBar();
+    }
+    
+    // Network usage visualization
+    ImGui::Separator();
+    ImGui::Text("Network Usage Visualization:");
+    
+    for (size_t i = 0; i < snapshot.network_interfaces.size(); ++i) {
+        const auto& iface = snapshot.network_interfaces[i];
+        const InterfaceText& cells = snapshot.interface_cells[i];
+        if (iface.name == "lo") continue; // Skip loopback interface
+        
+        float rx_gb = (float)iface.rx_bytes / (1024.0f * 1024.0f * 1024.0f);
+        float tx_gb = (float)iface.tx_bytes / (1024.0f * 1024.0f * 1024.0f);
+        float max_gb = 10.0f; // 10GB scale
+        
+        ImGui::Text("%s:", iface.name.c_str());
+        ImGui::Text("  RX: %s (%s)", text.Get(cells.rx_bytes), text.Get(cells.rx_rate));
+        ImGui::ProgressBar(std::min(rx_gb / max_gb, 1.0f), ImVec2(0, 0));
+        
+        ImGui::Text("  TX: %s (%s)", text.Get(cells.tx_bytes), text.Get(cells.tx_rate));
+        ImGui::ProgressBar(std::min(tx_gb / max_gb, 1.0f), ImVec2(0, 0));
+        
+        ImGui::Separator();
+    }
+}
+
+void NetworkView::RenderNetworkTable(const MonitorSnapshot& snapshot, bool is_rx) {
+    if (ImGui::BeginTable(is_rx ? "RXTable" : "TXTable", 8, 
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
+                         ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+        
+        ImGui::TableSetupColumn("Interface");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Packets");
+        ImGui::TableSetupColumn("Errors");
+        ImGui::TableSetupColumn("Drops");
+        if (is_rx) {
+            ImGui::TableSetupColumn("FIFO");
+            ImGui::TableSetupColumn("Frame");
+            ImGui::TableSetupColumn("Compressed");
+        } else {
+            ImGui::TableSetupColumn("FIFO");
+            ImGui::TableSetupColumn("Colls");
+            ImGui::TableSetupColumn("Carrier");
+        }
+        ImGui::TableHeadersRow();
+        
+        const TextArena& text = snapshot.network_text;
+        for (size_t i = 0; i < snapshot.network_interfaces.size(); ++i) {
+            const InterfaceText& cells = snapshot.interface_cells[i];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(snapshot.network_interfaces[i].name.c_str());
+            
+            ImGui::TableSetColumnIndex(1);
+            ImGui::TextUnformatted(text.Get(is_rx ? cells.rx_bytes : cells.tx_bytes));
+            
+            // Packets, errors, drops, FIFO, then frame/compressed or collisions/carrier
+            const TextRef* counts = is_rx ? cells.rx_counts : cells.tx_counts;
+            for (int c = 0; c < 6; ++c) {
+                ImGui::TableSetColumnIndex(2 + c);
+                ImGui::TextUnformatted(text.Get(counts[c]));
+            }
+        }
+        
+        ImGui::EndTable();
+    }
+}
+
+void NetworkView::RenderNetworkStatistics(const MonitorSnapshot& snapshot) {
+    const TextArena& text = snapshot.network_text;
+    if (ImGui::BeginTable("NetworkStats", 6, 
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | 
+                         ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+        
+        ImGui::TableSetupColumn("Interface");
+        ImGui::TableSetupColumn("Status");
+        ImGui::TableSetupColumn("Total RX");
+        ImGui::TableSetupColumn("Total TX");
+        ImGui::TableSetupColumn("RX Rate");
+        ImGui::TableSetupColumn("TX Rate");
+        ImGui::TableHeadersRow();
+        
+        for (size_t i = 0; i < snapshot.network_interfaces.size(); ++i) {
+            const auto& iface = snapshot.network_interfaces[i];
+            const InterfaceText& cells = snapshot.interface_cells[i];
+            ImGui::TableNextRow();
+            
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(iface.name.c_str());
+            
+            ImGui::TableSetColumnIndex(1);
+            if (iface.operational_status) {
+                ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "UP");
+            } else {
+                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "DOWN");
+            }
+            
+            ImGui::TableSetColumnIndex(2);
+            ImGui::TextUnformatted(text.Get(cells.rx_bytes));
+            
+            ImGui::TableSetColumnIndex(3);
+            ImGui::TextUnformatted(text.Get(cells.tx_bytes));
+            
+            ImGui::TableSetColumnIndex(4);
+            ImGui::TextUnformatted(text.Get(cells.rx_rate));
+            
+            ImGui::TableSetColumnIndex(5);
+            ImGui::TextUnformatted(text.Get(cells.tx_rate));
+        }
+        
+        ImGui::EndTable();
+    }
+    
+    // Additional statistics
+    ImGui::Separator();
+    ImGui::Text("Network Summary:");
+    
+    int active_interfaces = 0;
+    for (const auto& iface : snapshot.network_interfaces) {
+        if (iface.name != "lo" && iface.operational_status) { // Skip loopback
+            active_interfaces++;
+        }
+    }
+    
+    const NetworkTotalsText& totals = snapshot.network_totals;
+    ImGui::Text("Active Interfaces: %d", active_interfaces);
+    ImGui::Text("Total Data Received: %s", text.Get(totals.rx_bytes));
+    ImGui::Text("Total Data Transmitted: %s", text.Get(totals.tx_bytes));
+    ImGui::Text("Current RX Rate: %s", text.Get(totals.rx_rate));
+    ImGui::Text("Current TX Rate: %s", text.Get(totals.tx_rate));
+    ImGui::Text("Total Network Traffic: %s", text.Get(totals.traffic));
+    
+    // Show packet statistics
+    ImGui::Separator();
+    ImGui::Text("Packet Statistics:");
+    
+    uint64_t total_rx_packets = 0, total_tx_packets = 0;
+    uint64_t total_rx_errors = 0, total_tx_errors = 0;
+    uint64_t total_rx_drops = 0, total_tx_drops = 0;
+    
+    for (const auto& iface : snapshot.network_interfaces) {
+        if (iface.name != "lo") { // Skip loopback
+            total_rx_packets += iface.rx_packets;
+            total_tx_packets += iface.tx_packets;
+            total_rx_errors += iface.rx_errs;
+            total_tx_errors += iface.tx_errs;
+            total_rx_drops += iface.rx_drop;
+            total_tx_drops += iface.tx_drop;
+        }
+    }
+    
+    ImGui::Text("Total Packets Received: %llu", (unsigned long long)total_rx_packets);
+    ImGui::Text("Total Packets Transmitted: %llu", (unsigned long long)total_tx_packets);
+    ImGui::Text("Total RX Errors: %llu", (unsigned long long)total_rx_errors);
+    ImGui::Text("Total TX Errors: %llu", (unsigned long long)total_tx_errors);
+    ImGui::Text("Total RX Drops: %llu", (unsigned long long)total_rx_drops);
+    ImGui::Text("Total TX Drops: %llu", (unsigned long long)total_tx_drops);
+    
+    // Calculate error rates
+    if (total_rx_packets > 0) {
+        float rx_error_rate = (float)(total_rx_errors * 100.0 / total_rx_packets);
+        ImGui::Text("RX Error Rate: %.2f%%", rx_error_rate);
+    }
+    
+    if (total_tx_packets > 0) {
+        float tx_error_rate = (float)(total_tx_errors * 100.0 / total_tx_packets);
+        ImGui::Text("TX Error Rate: %.2f%%", tx_error_rate);
+    }
+}
@@ -0,0 +1,143 @@
+#include "collector.h"
+
+// LatencyHistogram Implementation
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_MAGNITUDE;
+const int LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& count : counts) count.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::BucketValue(int index) {
+    if (index < SUB_BUCKETS) return (uint64_t)index;
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t sub_bucket = (uint64_t)((index - SUB_BUCKETS) % SUB_BUCKETS);
+    uint64_t low = (SUB_BUCKETS + sub_bucket) << shift;
+    return low + ((1ull << shift) >> 1);
+}
+
+uint64_t LatencyHistogram::PercentileNs(double p) const {
+    Counts copy;
+    Read(copy);
+    return copy.PercentileNs(p);
+}
+
+void LatencyHistogram::Read(Counts& out) const {
+    for (int i = 0; i < BUCKET_COUNT; ++i) out.buckets[i] = counts[i].load(std::memory_order_relaxed);
+    out.total = Count();
+    out.sum_ns = SumNs();
+    out.max_ns = MaxNs();
+}
+
+void LatencyHistogram::Counts::Subtract(const Counts& base) {
+    // Copies are not atomic as a whole, so recount rather than trust total
+    total = 0;
+    int highest = -1;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] = buckets[i] > base.buckets[i] ? buckets[i] - base.buckets[i] : 0;
+        total += buckets[i];
+        if (buckets[i] > 0) highest = i;
+    }
+    sum_ns = sum_ns > base.sum_ns ? sum_ns - base.sum_ns : 0;
+    // The exact maximum is not kept per window; report the highest bucket like a percentile
+    if (highest >= 0) max_ns = std::min(BucketValue(highest), max_ns);
+    else max_ns = 0;
+}
+
+uint64_t LatencyHistogram::Counts::PercentileNs(double p) const {
+    if (total == 0) return 0;
+    uint64_t rank = (uint64_t)std::ceil(std::min(100.0, std::max(0.0, p)) / 100.0 * total);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        // A bucket's midpoint may lie above the largest value actually seen
+        if (seen >= rank) return std::min(BucketValue(i), max_ns);
+    }
+    return max_ns;
+}
+
+// SelfUsage Implementation
+const int SelfUsage::MIN_SAMPLE_MS;
+
+#ifdef _WIN32
+SelfUsage::SelfUsage() {}
+
+SelfUsage::~SelfUsage() {}
+
+void SelfUsage::Update() {
+    auto now = std::chrono::steady_clock::now();
+    if (previous_cpu_seconds >= 0.0 && now - previous_sample < std::chrono::milliseconds(MIN_SAMPLE_MS)) return;
+
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        ULARGE_INTEGER kernel, user;
+        kernel.LowPart = kernel_time.dwLowDateTime;
+        kernel.HighPart = kernel_time.dwHighDateTime;
+        user.LowPart = user_time.dwLowDateTime;
+        user.HighPart = user_time.dwHighDateTime;
+        stats.cpu_seconds = (kernel.QuadPart + user.QuadPart) / 10000000.0;  // FILETIME units
+    }
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        stats.resident_bytes = pmc.WorkingSetSize;
+    }
+
+    if (previous_cpu_seconds >= 0.0) {
+        double wall = std::chrono::duration<double>(now - previous_sample).count();
+        stats.cpu_percent = (float)((stats.cpu_seconds - previous_cpu_seconds) / wall * 100.0);
+    }
+    previous_cpu_seconds = stats.cpu_seconds;
+    previous_sample = now;
+}
+#else
+SelfUsage::SelfUsage() {
+    stat_fd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+    statm_fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    ticks_per_second = (double)sysconf(_SC_CLK_TCK);
+    page_size = sysconf(_SC_PAGESIZE);
+}
+
+SelfUsage::~SelfUsage() {
+    if (stat_fd >= 0) close(stat_fd);
+    if (statm_fd >= 0) close(statm_fd);
+}
+
+void SelfUsage::Update() {
+    auto now = std::chrono::steady_clock::now();
+    if (previous_cpu_seconds >= 0.0 && now - previous_sample < std::chrono::milliseconds(MIN_SAMPLE_MS)) return;
+
+    // The pid stat format, which ParseProcStat handles; num_threads is the
+    // 20th field, after the process name
+    char buffer[1024];
+    ssize_t len = stat_fd >= 0 ? pread(stat_fd, buffer, sizeof(buffer) - 1, 0) : -1;
+    ProcStat proc;
+    if (len > 0 && ParseProcStat(buffer, (size_t)len, proc)) {
+        stats.cpu_seconds = (proc.utime + proc.stime) / ticks_per_second;
+        buffer[len] = '\0';
+        const char* p = strrchr(buffer, ')');
+        for (int field = 3; p && field <= 20; ++field) p = strchr(p + 1, ' ');
+        if (p) stats.threads = atoi(p + 1);
+    }
+
+    // statm: size resident shared ... in pages
+    len = statm_fd >= 0 ? pread(statm_fd, buffer, sizeof(buffer) - 1, 0) : -1;
+    if (len > 0) {
+        buffer[len] = '\0';
+        unsigned long long size_pages = 0, resident_pages = 0;
+        if (sscanf(buffer, "%llu %llu", &size_pages, &resident_pages) == 2) {
+            stats.resident_bytes = resident_pages * (uint64_t)page_size;
+        }
+    }
+
+    if (previous_cpu_seconds >= 0.0) {
+        double wall = std::chrono::duration<double>(now - previous_sample).count();
+        stats.cpu_percent = (float)((stats.cpu_seconds - previous_cpu_seconds) / wall * 100.0);
+    }
+    previous_cpu_seconds = stats.cpu_seconds;
+    previous_sample = now;
+}
+#endif
@@ -0,0 +1,110 @@
+#include "header.h"
+
+std::string OverheadView::FormatDuration(uint64_t ns) {
+    const char* units[] = {"ns", "us", "ms", "s"};
+    int unit = 0;
+    double value = (double)ns;
+
+    while (value >= 1000.0 && unit < 3) {
+        value /= 1000.0;
+        unit++;
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f %s" : "%.1f %s", value, units[unit]);
+    return std::string(buffer);
+}
+
+// Rows of the table: each collector, publish, then the render phases
+static const int OVERHEAD_ROWS = COLLECTOR_COUNT + 1 + RENDER_PHASE_COUNT;
+
+static const LatencyHistogram& OverheadHistogram(int row) {
+    Collector& collector = g_monitor.GetCollector();
+    if (row < COLLECTOR_COUNT) return collector.GetCollectorLatency(row);
+    if (row == COLLECTOR_COUNT) return collector.GetPublishLatency();
+    return g_monitor.GetRenderLatency(row - COLLECTOR_COUNT - 1);
+}
+
+void OverheadView::Reset() {
+    baselines.resize(OVERHEAD_ROWS);
+    for (int row = 0; row < OVERHEAD_ROWS; ++row) {
+        OverheadHistogram(row).Read(baselines[row]);
+    }
+    reset_time = WallSeconds();
+}
+
+void OverheadView::LatencyRow(const char* name, int row) {
+    OverheadHistogram(row).Read(window);
+    if (!baselines.empty()) window.Subtract(baselines[row]);
+
+    ImGui::TableNextRow();
+
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("%s", name);
+
+    uint64_t count = window.total;
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%llu", (unsigned long long)count);
+    if (count == 0) return;
+
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%s", FormatDuration(window.PercentileNs(50.0)).c_str());
+
+    ImGui::TableSetColumnIndex(3);
+    ImGui::Text("%s", FormatDuration(window.PercentileNs(99.0)).c_str());
+
+    ImGui::TableSetColumnIndex(4);
+    ImGui::Text("%s", FormatDuration(window.max_ns).c_str());
+
+    ImGui::TableSetColumnIndex(5);
+    ImGui::Text("%s", FormatDuration(window.sum_ns / count).c_str());
+}
+
+void OverheadView::RenderOverhead(const MonitorSnapshot& snapshot) {
+    // Whole process, from /proc/self
+    ImGui::Text("CPU: %.1f%% of one core (%.1f s total)", snapshot.self.cpu_percent, snapshot.self.cpu_seconds);
+    ImGui::Text("Resident memory: %.1f MB | Threads: %d", snapshot.self.resident_bytes / (1024.0 * 1024.0),
+                snapshot.self.threads);
+
+    // Collector thread busy time, averaged since the last reset
+    uint64_t busy_ns = 0;
+    for (int row = 0; row <= COLLECTOR_COUNT; ++row) {
+        uint64_t sum_ns = OverheadHistogram(row).SumNs();
+        if (!baselines.empty()) sum_ns -= std::min(sum_ns, baselines[row].sum_ns);
+        busy_ns += sum_ns;
+    }
+    double elapsed = std::max(WallSeconds() - reset_time, 1e-3);
+    ImGui::Text("Collecting: %.2f%% of one core over %.0f s", busy_ns / 1e9 / elapsed * 100.0, elapsed);
+
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        Reset();
+    }
+
+    ImGui::Separator();
+
+    if (ImGui::BeginTable("OverheadTable", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                         ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("Mean");
+        ImGui::TableHeadersRow();
+
+        for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+            LatencyRow(CollectorScheduler::Name(c), c);
+        }
+        LatencyRow("publish", COLLECTOR_COUNT);
+
+        // Render phases nest inside the frame, and a tab only counts while it is open
+        for (int phase = 0; phase < RENDER_PHASE_COUNT; ++phase) {
+            char name[64];
+            snprintf(name, sizeof(name), "render: %s", SystemMonitor::RenderPhaseName(phase));
+            LatencyRow(name, COLLECTOR_COUNT + 1 + phase);
+        }
+
+        ImGui::EndTable();
+    }
+}
@@ -0,0 +1,154 @@
+#include "collector.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <string.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+
+// ProcEventListener Implementation
+ProcEventListener::~ProcEventListener() {
+    Stop();
+}
+
+bool ProcEventListener::Start() {
+    if (running) return true;
+    error.clear();
+
+    sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (sock < 0) {
+        error = std::string("socket: ") + strerror(errno);
+        return false;
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        error = std::string("bind: ") + strerror(errno);
+        close(sock);
+        sock = -1;
+        return false;
+    }
+
+    // Ask the connector to start multicasting process events
+    alignas(NLMSG_ALIGNTO) char buf[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+    memset(buf, 0, sizeof(buf));
+    struct nlmsghdr* header = (struct nlmsghdr*)buf;
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = getpid();
+
+    struct cn_msg* msg = (struct cn_msg*)NLMSG_DATA(header);
+    msg->id.idx = CN_IDX_PROC;
+    msg->id.val = CN_VAL_PROC;
+    msg->len = sizeof(enum proc_cn_mcast_op);
+    *(enum proc_cn_mcast_op*)msg->data = PROC_CN_MCAST_LISTEN;
+
+    if (send(sock, header, header->nlmsg_len, 0) < 0) {
+        error = std::string("subscribe: ") + strerror(errno);
+        close(sock);
+        sock = -1;
+        return false;
+    }
+
+    proc_fd = open(ProcRoot().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    running = true;
+    thread = std::thread(&ProcEventListener::ListenLoop, this);
+    return true;
+}
+
+void ProcEventListener::Stop() {
+    if (!running) return;
+    running = false;
+    if (thread.joinable()) thread.join();
+
+    close(sock);
+    sock = -1;
+    if (proc_fd >= 0) {
+        close(proc_fd);
+        proc_fd = -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+void ProcEventListener::Drain(std::vector<ProcEvent>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    out.swap(pending);
+    has_pending = false;
+}
+
+void ProcEventListener::SetNotify(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    notify = std::move(callback);
+}
+
+void ProcEventListener::ListenLoop() {
+    alignas(NLMSG_ALIGNTO) char buf[8192];
+    struct pollfd pfd = {sock, POLLIN, 0};
+
+    while (running) {
+        // Wake up periodically so Stop() never waits long
+        if (poll(&pfd, 1, 250) <= 0) continue;
+
+        ssize_t len = recv(sock, buf, sizeof(buf), 0);
+        if (len <= 0) {
+            // ENOBUFS means events were dropped; the next scan reconciles
+            if (len < 0 && errno == ENOBUFS) dropped++;
+            continue;
+        }
+
+        for (struct nlmsghdr* header = (struct nlmsghdr*)buf; NLMSG_OK(header, len);
+             header = NLMSG_NEXT(header, len)) {
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_NOOP) continue;
+
+            struct cn_msg* msg = (struct cn_msg*)NLMSG_DATA(header);
+            if (msg->id.idx != CN_IDX_PROC || msg->id.val != CN_VAL_PROC) continue;
+            struct proc_event* event = (struct proc_event*)msg->data;
+
+            // Only whole processes (thread group leaders) are tracked
+            ProcEvent out;
+            out.timestamp_ns = event->timestamp_ns;
+            switch (event->what) {
+                case proc_event::PROC_EVENT_FORK:
+                    if (event->event_data.fork.child_pid != event->event_data.fork.child_tgid) continue;
+                    out.type = ProcEvent::FORK;
+                    out.pid = event->event_data.fork.child_pid;
+                    break;
+                case proc_event::PROC_EVENT_EXEC:
+                    if (event->event_data.exec.process_pid != event->event_data.exec.process_tgid) continue;
+                    out.type = ProcEvent::EXEC;
+                    out.pid = event->event_data.exec.process_pid;
+                    break;
+                case proc_event::PROC_EVENT_EXIT:
+                    if (event->event_data.exit.process_pid != event->event_data.exit.process_tgid) continue;
+                    out.type = ProcEvent::EXIT;
+                    out.pid = event->event_data.exit.process_pid;
+                    out.exit_code = (int)event->event_data.exit.exit_code;
+                    break;
+                default:
+                    continue;
+            }
+
+            // Catch name and starttime now; a short-lived process is gone by the next tick
+            if (out.type != ProcEvent::EXIT && proc_fd >= 0) {
+                out.has_stat = ReadProcStat(proc_fd, out.pid, out.stat);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending.size() >= MAX_PENDING) {
+                dropped++;
+                continue;
+            }
+            pending.push_back(out);
+            // Only the first event of a batch wakes the collector
+            if (!has_pending.exchange(true) && notify) notify();
+        }
+    }
+}
+#endif
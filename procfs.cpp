@@ -0,0 +1,273 @@
+#include "collector.h"
+
+struct SystemRoots {
+    std::string proc = "/proc";
+    std::string sys = "/sys";
+};
+
+static SystemRoots& Roots() {
+    static SystemRoots roots = [] {
+        SystemRoots loaded;
+        Config config;
+        config.Load(Config::DefaultPath());
+        loaded.proc = config.Get("root.proc", loaded.proc);
+        loaded.sys = config.Get("root.sys", loaded.sys);
+        if (const char* proc = getenv("SYSMON_PROC_ROOT")) loaded.proc = proc;
+        if (const char* sys = getenv("SYSMON_SYS_ROOT")) loaded.sys = sys;
+        return loaded;
+    }();
+    return roots;
+}
+
+const std::string& ProcRoot() {
+    return Roots().proc;
+}
+
+const std::string& SysRoot() {
+    return Roots().sys;
+}
+
+void SetSystemRoots(const std::string& proc_root, const std::string& sys_root) {
+    Roots().proc = proc_root;
+    Roots().sys = sys_root;
+}
+
+bool UsingHostRoots() {
+    return Roots().proc == "/proc" && Roots().sys == "/sys";
+}
+
+#ifndef _WIN32
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+// Parse an unsigned/signed decimal field and advance the cursor past it
+static bool ParseField(const char*& p, const char* end, int64_t& value) {
+    while (p < end && *p == ' ') ++p;
+    if (p >= end) return false;
+
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        ++p;
+    }
+
+    const char* start = p;
+    uint64_t v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (uint64_t)(*p - '0');
+        ++p;
+    }
+    if (p == start) return false;
+
+    value = negative ? -(int64_t)v : (int64_t)v;
+    return true;
+}
+
+bool ParseProcStat(const char* buf, size_t len, ProcStat& out) {
+    const char* end = buf + len;
+    const char* p = buf;
+
+    int64_t pid;
+    if (!ParseField(p, end, pid)) return false;
+    out.pid = (int)pid;
+
+    // comm is wrapped in parentheses and may itself contain spaces or ')',
+    // so it runs from the first '(' to the last ')' on the line
+    const char* open_paren = (const char*)memchr(p, '(', end - p);
+    const char* close_paren = (const char*)memrchr(p, ')', end - p);
+    if (!open_paren || !close_paren || close_paren < open_paren) return false;
+
+    size_t comm_len = std::min((size_t)(close_paren - open_paren - 1), sizeof(out.comm) - 1);
+    memcpy(out.comm, open_paren + 1, comm_len);
+    out.comm[comm_len] = '\0';
+
+    p = close_paren + 1;
+    while (p < end && *p == ' ') ++p;
+    if (p >= end) return false;
+    out.state = *p++;
+
+    // Fields 4 (ppid) through 24 (rss), see proc(5)
+    int64_t fields[21];
+    for (int i = 0; i < 21; ++i) {
+        if (!ParseField(p, end, fields[i])) return false;
+    }
+
+    out.utime = (uint64_t)fields[10];
+    out.stime = (uint64_t)fields[11];
+    out.cutime = fields[12];
+    out.cstime = fields[13];
+    out.starttime = (uint64_t)fields[18];
+    out.vsize = (uint64_t)fields[19];
+    out.rss = fields[20];
+    return true;
+}
+
+static bool ReadProcStatPath(int proc_fd, const char* path, ProcStat& out) {
+    int fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // Everything up to rss fits comfortably; a truncated tail is never parsed
+    char buf[1024];
+    ssize_t n = read(fd, buf, sizeof(buf));
+    close(fd);
+    if (n <= 0) return false;
+
+    return ParseProcStat(buf, (size_t)n, out);
+}
+
+bool ReadProcStat(int proc_fd, const char* pid_name, ProcStat& out) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/stat", pid_name);
+    return ReadProcStatPath(proc_fd, path, out);
+}
+
+bool ReadProcStat(int proc_fd, int pid, ProcStat& out) {
+    char path[32];
+    snprintf(path, sizeof(path), "%d/stat", pid);
+    return ReadProcStatPath(proc_fd, path, out);
+}
+
+// Layout of the records returned by getdents64(2)
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+bool ListProcPids(int proc_fd, std::vector<int>& pids) {
+    pids.clear();
+    if (lseek(proc_fd, 0, SEEK_SET) < 0) return false;
+
+    alignas(8) char buf[32768];
+    while (true) {
+        long n = syscall(SYS_getdents64, proc_fd, buf, sizeof(buf));
+        if (n < 0) return false;
+        if (n == 0) break;
+
+        for (long offset = 0; offset < n; ) {
+            const LinuxDirent64* entry = (const LinuxDirent64*)(buf + offset);
+            offset += entry->d_reclen;
+
+            const char* name = entry->d_name;
+            if (*name < '0' || *name > '9') continue;
+
+            int pid = 0;
+            while (*name >= '0' && *name <= '9') pid = pid * 10 + (*name++ - '0');
+            pids.push_back(pid);
+        }
+    }
+    return true;
+}
+
+void ScanProcStats(int proc_fd, const std::vector<int>& pids, WorkerPool& pool, int shards,
+                   std::vector<std::vector<ProcStat>>& results) {
+    if (shards < 1) shards = 1;
+    results.resize(shards);
+
+    pool.Run(shards, [&](int shard) {
+        std::vector<ProcStat>& out = results[shard];
+        out.clear();
+
+        size_t begin = pids.size() * shard / shards;
+        size_t end = pids.size() * (shard + 1) / shards;
+        ProcStat stat;
+        for (size_t i = begin; i < end; ++i) {
+            // Processes that exit between listing and reading are skipped
+            if (ReadProcStat(proc_fd, pids[i], stat)) out.push_back(stat);
+        }
+    });
+}
+
+// SourceCache Implementation
+const int SourceCache::REVALIDATE_INTERVAL;
+
+SourceCache::~SourceCache() {
+    for (auto& source : sources) {
+        Close(source);
+    }
+}
+
+int SourceCache::Register(const std::string& path) {
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i].path == path) return (int)i;
+    }
+
+    Source source;
+    source.path = path;
+    Open(source);
+    sources.push_back(source);
+    return (int)sources.size() - 1;
+}
+
+bool SourceCache::Open(Source& source) {
+    Close(source);
+    source.reads_until_check = REVALIDATE_INTERVAL;
+
+    source.fd = open(source.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source.fd < 0) return false;
+
+    struct stat st;
+    if (fstat(source.fd, &st) == 0) {
+        source.dev = st.st_dev;
+        source.ino = st.st_ino;
+    }
+    return true;
+}
+
+void SourceCache::Close(Source& source) {
+    if (source.fd >= 0) {
+        close(source.fd);
+        source.fd = -1;
+    }
+}
+
+void SourceCache::Invalidate(int handle) {
+    if (handle < 0 || handle >= (int)sources.size()) return;
+    Close(sources[handle]);
+    sources[handle].reads_until_check = 0;
+}
+
+ssize_t SourceCache::Read(int handle, std::vector<char>& buf) {
+    if (handle < 0 || handle >= (int)sources.size()) return -1;
+    Source& source = sources[handle];
+
+    // Every few reads make sure the path still names the file we hold open;
+    // missing sources are retried at the same cadence rather than every tick
+    if (--source.reads_until_check <= 0) {
+        struct stat st;
+        bool exists = stat(source.path.c_str(), &st) == 0;
+        if (source.fd < 0 || !exists || st.st_dev != source.dev || st.st_ino != source.ino) {
+            if (!exists || !Open(source)) {
+                Close(source);
+                source.reads_until_check = REVALIDATE_INTERVAL;
+                return -1;
+            }
+        }
+        source.reads_until_check = REVALIDATE_INTERVAL;
+    }
+    if (source.fd < 0) return -1;
+
+    if (buf.size() < 4096) buf.resize(4096);
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        ssize_t n;
+        while ((n = pread(source.fd, buf.data(), buf.size() - 1, 0)) == (ssize_t)buf.size() - 1) {
+            // Possibly truncated, grow and read again from the start
+            buf.resize(buf.size() * 2);
+        }
+        if (n >= 0) {
+            buf[n] = '\0';
+            return n;
+        }
+
+        // The device behind the fd went away; reopen once and retry
+        if (!Open(source)) break;
+    }
+
+    Close(source);
+    return -1;
+}
+#endif
@@ -0,0 +1,63 @@
+#include "collector.h"
+
+// CollectorScheduler Implementation
+const int CollectorScheduler::MIN_INTERVAL_MS;
+const int CollectorScheduler::MAX_INTERVAL_MS;
+
+CollectorScheduler::CollectorScheduler() {
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        interval_ms[c] = DefaultInterval(c);
+    }
+}
+
+const char* CollectorScheduler::Name(int collector) {
+    static const char* names[COLLECTOR_COUNT] = {"cpu", "thermal", "memory", "processes", "disk", "network"};
+    return collector >= 0 && collector < COLLECTOR_COUNT ? names[collector] : "?";
+}
+
+int CollectorScheduler::DefaultInterval(int collector) {
+    // Cheap counters sample fast; the process scan and statvfs are the expensive ones
+    static const int defaults[COLLECTOR_COUNT] = {250, 1000, 1000, 2000, 5000, 1000};
+    return collector >= 0 && collector < COLLECTOR_COUNT ? defaults[collector] : 1000;
+}
+
+void CollectorScheduler::SetInterval(int collector, int ms) {
+    if (collector < 0 || collector >= COLLECTOR_COUNT) return;
+    interval_ms[collector] = std::max(MIN_INTERVAL_MS, std::min(ms, MAX_INTERVAL_MS));
+}
+
+void CollectorScheduler::Start(Clock::time_point now) {
+    heap.clear();
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        heap.push_back({now, c});
+    }
+    std::make_heap(heap.begin(), heap.end(), Later);
+}
+
+void CollectorScheduler::Reschedule(Clock::time_point now) {
+    for (auto& deadline : heap) {
+        deadline.when = std::min(deadline.when, now + std::chrono::milliseconds(interval_ms[deadline.collector]));
+    }
+    std::make_heap(heap.begin(), heap.end(), Later);
+}
+
+void CollectorScheduler::PopDue(Clock::time_point now, bool due[COLLECTOR_COUNT]) {
+    while (!heap.empty() && heap.front().when <= now) {
+        std::pop_heap(heap.begin(), heap.end(), Later);
+        Deadline& deadline = heap.back();
+        due[deadline.collector] = true;
+
+        // Next slot on the original grid; after a stall skip the missed ones
+        auto interval = std::chrono::milliseconds(interval_ms[deadline.collector]);
+        deadline.when += interval;
+        if (deadline.when <= now) {
+            deadline.when += ((now - deadline.when) / interval + 1) * interval;
+        }
+        std::push_heap(heap.begin(), heap.end(), Later);
+    }
+}
+
+CollectorScheduler::Clock::time_point CollectorScheduler::NextDeadline() const {
+    if (heap.empty()) return Clock::now() + std::chrono::milliseconds(MAX_INTERVAL_MS);
+    return heap.front().when;
+}
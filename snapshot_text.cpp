@@ -0,0 +1,64 @@
+#include "collector.h"
+
+// Render-ready text of each snapshot section, formatted once per tick on
+// the collector thread so the views draw it without formatting
+
+void FormatSystemText(MonitorSnapshot& snapshot) {
+    const SystemInfo& info = snapshot.system_info;
+    TextArena& text = snapshot.system_text;
+    text.Clear();
+    snapshot.memory_usage_text = text.AddUsage(info.used_memory, info.total_memory);
+    snapshot.swap_usage_text = text.AddUsage(info.used_swap, info.total_swap);
+    snapshot.disk_usage_text = text.AddUsage(info.used_disk, info.total_disk);
+}
+
+void FormatProcessText(MonitorSnapshot& snapshot) {
+    const auto& rows = snapshot.processes;
+    TextArena& text = snapshot.process_text;
+    text.Clear();
+    snapshot.process_cells.resize(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        // Tombstoned rows are never drawn
+        if (!rows[i].alive) continue;
+        ProcessText& cells = snapshot.process_cells[i];
+        cells.pid = text.AddNumber(rows[i].pid);
+        cells.cpu = text.AddFixed(rows[i].cpu_usage, 1);
+        cells.memory = text.AddFixed(rows[i].memory_usage, 2);
+    }
+}
+
+void FormatNetworkText(MonitorSnapshot& snapshot) {
+    const auto& interfaces = snapshot.network_interfaces;
+    TextArena& text = snapshot.network_text;
+    text.Clear();
+    snapshot.interface_cells.resize(interfaces.size());
+    uint64_t rx_total = 0, tx_total = 0, rx_rate_total = 0, tx_rate_total = 0;
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        const NetworkInterface& iface = interfaces[i];
+        InterfaceText& cells = snapshot.interface_cells[i];
+        cells.rx_bytes = text.AddBytes(iface.rx_bytes);
+        cells.tx_bytes = text.AddBytes(iface.tx_bytes);
+        cells.rx_rate = text.AddRate(iface.rx_rate);
+        cells.tx_rate = text.AddRate(iface.tx_rate);
+        const uint64_t rx_counts[6] = {iface.rx_packets, iface.rx_errs, iface.rx_drop,
+                                       iface.rx_fifo, iface.rx_frame, iface.rx_compressed};
+        const uint64_t tx_counts[6] = {iface.tx_packets, iface.tx_errs, iface.tx_drop,
+                                       iface.tx_fifo, iface.tx_colls, iface.tx_carrier};
+        for (int c = 0; c < 6; ++c) {
+            cells.rx_counts[c] = text.AddNumber(rx_counts[c]);
+            cells.tx_counts[c] = text.AddNumber(tx_counts[c]);
+        }
+        if (iface.name != "lo") {
+            rx_total += iface.rx_bytes;
+            tx_total += iface.tx_bytes;
+            rx_rate_total += iface.rx_rate;
+            tx_rate_total += iface.tx_rate;
+        }
+    }
+    NetworkTotalsText& totals = snapshot.network_totals;
+    totals.rx_bytes = text.AddBytes(rx_total);
+    totals.tx_bytes = text.AddBytes(tx_total);
+    totals.rx_rate = text.AddRate(rx_rate_total);
+    totals.tx_rate = text.AddRate(tx_rate_total);
+    totals.traffic = text.AddBytes(rx_total + tx_total);
+}
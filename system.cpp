@@ -1,13 +1,73 @@
-#include "header.h"
+#include "collector.h"
 
-// SystemManager Implementation
-SystemManager::SystemManager() {
-    cpu_history.reserve(HISTORY_SIZE);
-    fan_history.reserve(HISTORY_SIZE);
-    temp_history.reserve(HISTORY_SIZE);
+// CPUTimes Implementation
+void CPUTimes::Resize(size_t count) {
+    slots = count;
+    has_previous = false;
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        ticks[f].assign(count, 0);
+        previous[f].assign(count, 0);
+    }
+    for (int s = 0; s < SHARE_COUNT; ++s) {
+        percent[s].assign(count, 0.0f);
+    }
+    busy.assign(count, 0.0f);
+    ids.assign(count, -1);
 }
 
-const int SystemManager::HISTORY_SIZE;
+static inline float TickDelta(uint64_t current, uint64_t previous) {
+    // Counters can go backwards when a core is offlined and brought back
+    return current > previous ? (float)(current - previous) : 0.0f;
+}
+
+void CPUTimes::Compute() {
+    const size_t n = slots;
+    if (has_previous) {
+        const uint64_t* u = ticks[USER].data();     const uint64_t* pu = previous[USER].data();
+        const uint64_t* ni = ticks[NICE].data();    const uint64_t* pni = previous[NICE].data();
+        const uint64_t* sy = ticks[SYSTEM].data();  const uint64_t* psy = previous[SYSTEM].data();
+        const uint64_t* id = ticks[IDLE].data();    const uint64_t* pid = previous[IDLE].data();
+        const uint64_t* io = ticks[IOWAIT].data();  const uint64_t* pio = previous[IOWAIT].data();
+        const uint64_t* ir = ticks[IRQ].data();     const uint64_t* pir = previous[IRQ].data();
+        const uint64_t* so = ticks[SOFTIRQ].data(); const uint64_t* pso = previous[SOFTIRQ].data();
+        const uint64_t* st = ticks[STEAL].data();   const uint64_t* pst = previous[STEAL].data();
+        float* out_user = percent[SHARE_USER].data();
+        float* out_system = percent[SHARE_SYSTEM].data();
+        float* out_iowait = percent[SHARE_IOWAIT].data();
+        float* out_irq = percent[SHARE_IRQ].data();
+        float* out_softirq = percent[SHARE_SOFTIRQ].data();
+        float* out_steal = percent[SHARE_STEAL].data();
+        float* out_idle = percent[SHARE_IDLE].data();
+        float* out_busy = busy.data();
+
+        // One straight-line pass over every slot, no branches besides the clamps
+        for (size_t i = 0; i < n; ++i) {
+            float d_user = TickDelta(u[i], pu[i]) + TickDelta(ni[i], pni[i]);
+            float d_system = TickDelta(sy[i], psy[i]);
+            float d_idle = TickDelta(id[i], pid[i]);
+            float d_iowait = TickDelta(io[i], pio[i]);
+            float d_irq = TickDelta(ir[i], pir[i]);
+            float d_softirq = TickDelta(so[i], pso[i]);
+            float d_steal = TickDelta(st[i], pst[i]);
+            float total = d_user + d_system + d_idle + d_iowait + d_irq + d_softirq + d_steal;
+            float scale = total > 0.0f ? 100.0f / total : 0.0f;
+
+            out_user[i] = d_user * scale;
+            out_system[i] = d_system * scale;
+            out_iowait[i] = d_iowait * scale;
+            out_irq[i] = d_irq * scale;
+            out_softirq[i] = d_softirq * scale;
+            out_steal[i] = d_steal * scale;
+            out_idle[i] = d_idle * scale;
+            out_busy[i] = (d_user + d_system + d_irq + d_softirq) * scale;
+        }
+    }
+
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        previous[f].swap(ticks[f]);
+    }
+    has_previous = true;
+}
 
 void SystemManager::Initialize() {
 #ifdef _WIN32
@@ -18,26 +78,52 @@ void SystemManager::Initialize() {
 }
 
 void SystemManager::Update() {
+    UpdateCPU();
+    UpdateThermal();
+}
+
+void SystemManager::UpdateCPU() {
 #ifdef _WIN32
     UpdateWindows();
 #else
-    UpdateLinux();
+    UpdateCPUUsage();
 #endif
 
-    // Update history
-    if (g_monitor.GetAnimateGraphs()) {
-        cpu_history.push_back(system_info.cpu_usage);
-        fan_history.push_back((float)system_info.fan_speed);
-        temp_history.push_back(system_info.temperature);
-        
-        if (cpu_history.size() > HISTORY_SIZE * 2) {
-            cpu_history.erase(cpu_history.begin(), cpu_history.begin() + (cpu_history.size() - HISTORY_SIZE));
-            fan_history.erase(fan_history.begin());
-            temp_history.erase(temp_history.begin());
+    // History keeps recording while the graphs are paused
+    double now = WallSeconds();
+    HistoryBucket completed;
+    if (cpu_history.Add(now, system_info.cpu_usage, &completed)) {
+        history_store.Append(METRIC_CPU, completed);
+    }
+    for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+        if (cpu_share_history[s].Add(now, cpu_times.slots > 0 ? cpu_times.percent[s][0] : 0.0f, &completed)) {
+            history_store.Append(METRIC_CPU_SHARE + s, completed);
+        }
+    }
+    if (cpu_times.has_previous) {
+        char name[16];
+        for (int core = 0; core < cpu_times.CoreCount(); ++core) {
+            snprintf(name, sizeof(name), "cpu%d", cpu_times.CoreId(core));
+            RecordSeries(name, now, cpu_times.busy[core + 1]);
         }
     }
 }
 
+void SystemManager::UpdateThermal() {
+#ifndef _WIN32
+    UpdateThermalInfo();
+#endif
+
+    double now = WallSeconds();
+    HistoryBucket completed;
+    if (fan_history.Add(now, (float)system_info.fan_speed, &completed)) {
+        history_store.Append(METRIC_FAN, completed);
+    }
+    if (temp_history.Add(now, system_info.temperature, &completed)) {
+        history_store.Append(METRIC_TEMP, completed);
+    }
+}
+
 #ifdef _WIN32
 void SystemManager::InitializeWindows() {
     // Get OS info
@@ -116,8 +202,25 @@ void SystemManager::InitializeLinux() {
     gethostname(hostname, sizeof(hostname));
     system_info.hostname = hostname;
     
+    // Sources re-read every tick
+    stat_source = sources.Register(ProcRoot() + "/stat");
+    std::string thermal_dir = SysRoot() + "/class/thermal";
+    if (DIR* dir = opendir(thermal_dir.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            ThermalZone zone;
+            if (sscanf(entry->d_name, "thermal_zone%d", &zone.zone) == 1) system_info.thermal_zones.push_back(zone);
+        }
+        closedir(dir);
+        std::sort(system_info.thermal_zones.begin(), system_info.thermal_zones.end(),
+                  [](const ThermalZone& a, const ThermalZone& b) { return a.zone < b.zone; });
+        for (const ThermalZone& zone : system_info.thermal_zones) {
+            temp_sources.push_back(sources.Register(thermal_dir + "/thermal_zone" + std::to_string(zone.zone) + "/temp"));
+        }
+    }
+    fan_source = sources.Register(SysRoot() + "/class/hwmon/hwmon1/fan1_input");
+    
     // Get CPU info
-    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::ifstream cpuinfo(ProcRoot() + "/cpuinfo");
     std::string line;
     while (std::getline(cpuinfo, line)) {
         if (line.find("model name") != std::string::npos) {
@@ -130,193 +233,154 @@ void SystemManager::InitializeLinux() {
     }
 }
 
-void SystemManager::UpdateLinux() {
-    UpdateCPUUsage();
-    UpdateThermalInfo();
+// N of a "cpuN" line, -1 for the "cpu" total
+static int ParseCoreId(const char* p) {
+    if (*p < '0' || *p > '9') return -1;
+    int id = 0;
+    while (*p >= '0' && *p <= '9') id = id * 10 + (*p++ - '0');
+    return id;
 }
 
 void SystemManager::UpdateCPUUsage() {
-    static unsigned long long lastTotalUser, lastTotalUserLow, lastTotalSys, lastTotalIdle;
+    if (sources.Read(stat_source, read_buffer) <= 0) return;
     
-    std::ifstream file("/proc/stat");
-    std::string line;
-    std::getline(file, line);
-    
-    std::istringstream iss(line);
-    std::string cpu;
-    unsigned long long user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice;
-    
-    iss >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal >> guest >> guest_nice;
+    // Leading lines: "cpu  user nice system idle iowait irq softirq steal guest guest_nice",
+    // then one "cpuN ..." line per online core
+    size_t line_count = 0;
+    bool cores_changed = false;
+    for (const char* line = read_buffer.data(); strncmp(line, "cpu", 3) == 0; ) {
+        if (line_count >= cpu_times.slots || cpu_times.ids[line_count] != ParseCoreId(line + 3)) cores_changed = true;
+        line_count++;
+        const char* eol = strchr(line, '\n');
+        if (!eol) break;
+        line = eol + 1;
+    }
+    if (line_count == 0) return;
     
-    unsigned long long totalUser = user + nice;
-    unsigned long long totalSys = system + irq + softirq;
-    unsigned long long totalIdle = idle + iowait;
-    unsigned long long total = totalUser + totalSys + totalIdle;
+    // Cores coming or going restart the deltas, even when the count stays the same
+    if (cores_changed || line_count != cpu_times.slots) {
+        cpu_times.Resize(line_count);
+    }
     
-    if (lastTotalUser != 0) {
-        unsigned long long totalDiff = total - (lastTotalUser + lastTotalSys + lastTotalIdle);
-        unsigned long long idleDiff = totalIdle - lastTotalIdle;
-        
-        system_info.cpu_usage = (float)((totalDiff - idleDiff) * 100.0 / totalDiff);
+    const char* p = read_buffer.data();
+    for (size_t slot = 0; slot < line_count; ++slot) {
+        p += 3;
+        cpu_times.ids[slot] = ParseCoreId(p);
+        while (*p >= '0' && *p <= '9') p++;
+        for (int f = 0; f < CPUTimes::FIELD_COUNT; ++f) {
+            char* next;
+            cpu_times.ticks[f][slot] = strtoull(p, &next, 10);
+            p = next;
+        }
+        p = strchr(p, '\n');
+        if (!p) break;
+        p++;
     }
     
-    lastTotalUser = totalUser;
-    lastTotalSys = totalSys;
-    lastTotalIdle = totalIdle;
+    bool first_sample = !cpu_times.has_previous;
+    cpu_times.Compute();
+    if (!first_sample) {
+        system_info.cpu_usage = cpu_times.busy[0];
+    }
 }
 
 void SystemManager::UpdateThermalInfo() {
-    // Try to read temperature from thermal zones
-    std::ifstream temp_file("/sys/class/thermal/thermal_zone0/temp");
-    if (temp_file.is_open()) {
-        int temp_millicelsius;
-        temp_file >> temp_millicelsius;
-        system_info.temperature = temp_millicelsius / 1000.0f;
+    // Every zone is read for the exporters; the configured one is the temperature
+    for (size_t z = 0; z < temp_sources.size(); ++z) {
+        if (sources.Read(temp_sources[z], read_buffer) <= 0) continue;
+        ThermalZone& zone = system_info.thermal_zones[z];
+        zone.temperature = atoi(read_buffer.data()) / 1000.0f;
+        if (zone.zone == temperature_zone) system_info.temperature = zone.temperature;
     }
     
     // Try to read fan info (simplified)
-    std::ifstream fan_file("/sys/class/hwmon/hwmon1/fan1_input");
-    if (fan_file.is_open()) {
-        fan_file >> system_info.fan_speed;
+    if (sources.Read(fan_source, read_buffer) > 0) {
+        system_info.fan_speed = atoi(read_buffer.data());
         system_info.fan_active = system_info.fan_speed > 0;
     }
 }
 #endif
 
-void SystemManager::RenderSystemInfo() {
-    // Basic system information
-    ImGui::Text("Operating System: %s", system_info.os_type.c_str());
-    ImGui::Text("User: %s", system_info.username.c_str());
-    ImGui::Text("Hostname: %s", system_info.hostname.c_str());
-    ImGui::Text("Total Processes: %d", system_info.total_processes);
-    ImGui::Text("Running: %d, Sleeping: %d, Zombie: %d, Stopped: %d", 
-               system_info.running_processes, system_info.sleeping_processes,
-               system_info.zombie_processes, system_info.stopped_processes);
-    ImGui::Text("CPU: %s", system_info.cpu_type.c_str());
-    
-    ImGui::Separator();
-    
-    // Performance tabs
-    if (ImGui::BeginTabBar("PerformanceTabs")) {
-        if (ImGui::BeginTabItem("CPU")) {
-            RenderCPUTab();
-            ImGui::EndTabItem();
+void SystemManager::WriteSnapshot(MonitorSnapshot& snapshot, const bool stale[COLLECTOR_COUNT]) const {
+    // Every collector writes a few fields of system_info, so it is always copied
+    snapshot.system_info = system_info;
+    FormatSystemText(snapshot);
+    if (stale[COLLECT_CPU]) {
+        snapshot.cpu_history = cpu_history.GetView();
+        for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+            snapshot.cpu_share_history[s] = cpu_share_history[s].GetView();
         }
-        
-        if (ImGui::BeginTabItem("Fan")) {
-            RenderFanTab();
-            ImGui::EndTabItem();
-        }
-        
-        if (ImGui::BeginTabItem("Thermal")) {
-            RenderThermalTab();
-            ImGui::EndTabItem();
-        }
-        
-        ImGui::EndTabBar();
+        snapshot.cpu_times = cpu_times;
+    }
+    if (stale[COLLECT_THERMAL]) {
+        snapshot.fan_history = fan_history.GetView();
+        snapshot.temp_history = temp_history.GetView();
     }
 }
 
-void SystemManager::RenderCPUTab() {
-    ImGui::Text("CPU Usage: %.1f%%", system_info.cpu_usage);
-    
-    RenderGraphControls();
-    
-    if (!cpu_history.empty()) {
-        static int display_start = 0;
-
-        if (g_monitor.GetAnimateGraphs()) {
-            display_start = std::max(0, (int)cpu_history.size() - HISTORY_SIZE);
-        }
-
-        int display_count = std::min(HISTORY_SIZE, (int)cpu_history.size() - display_start);
+static const char* CPU_SHARE_NAMES[CPUTimes::SHARE_COUNT] = {
+    "user", "system", "iowait", "irq", "softirq", "steal", "idle"
+};
 
-        ImGui::PlotLines("CPU Usage", cpu_history.data() + display_start, display_count, 
-                       0, nullptr, 0.0f, g_monitor.GetGraphYScale(), ImVec2(0, 200));
-        
-        // Overlay text
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 50);
-        ImGui::Text("Current: %.1f%%", system_info.cpu_usage);
-    }
+const char* CPUTimes::ShareName(int share) {
+    return share >= 0 && share < SHARE_COUNT ? CPU_SHARE_NAMES[share] : "?";
 }
 
-void SystemManager::RenderFanTab() {
-    ImGui::Text("Fan Status: %s", system_info.fan_active ? "Active" : "Inactive");
-    ImGui::Text("Fan Speed: %d RPM", system_info.fan_speed);
-    
-    RenderGraphControls();
-    
-    if (!fan_history.empty()) {
-        float max_speed = *std::max_element(fan_history.begin(), fan_history.end());
-        ImGui::PlotLines("Fan Speed", fan_history.data(), fan_history.size(), 
-                       0, nullptr, 0.0f, max_speed, ImVec2(0, 200));
+std::string SystemManager::MetricName(int metric) {
+    static const char* names[METRIC_CPU_SHARE] = {"cpu", "fan", "temp"};
+    if (metric >= 0 && metric < METRIC_CPU_SHARE) return names[metric];
+    if (metric >= METRIC_CPU_SHARE && metric < METRIC_COUNT) {
+        return std::string("cpu.") + CPU_SHARE_NAMES[metric - METRIC_CPU_SHARE];
     }
+    return "?";
 }
 
-void SystemManager::RenderThermalTab() {
-    ImGui::Text("Temperature: %.1f°C", system_info.temperature);
-    
-    RenderGraphControls();
-    
-    if (!temp_history.empty()) {
-        ImGui::PlotLines("Temperature", temp_history.data(), temp_history.size(), 
-                       0, nullptr, 0.0f, 100.0f, ImVec2(0, 200));
-        
-        // Overlay text
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 50);
-        ImGui::Text("Current: %.1f°C", system_info.temperature);
-    }
+TieredHistory& SystemManager::MetricHistory(int metric) {
+    if (metric == METRIC_FAN) return fan_history;
+    if (metric == METRIC_TEMP) return temp_history;
+    if (metric >= METRIC_CPU_SHARE && metric < METRIC_COUNT) return cpu_share_history[metric - METRIC_CPU_SHARE];
+    return cpu_history;
 }
 
-void SystemManager::RenderGraphControls() {
-    bool animate = g_monitor.GetAnimateGraphs();
-    if (ImGui::Checkbox("Animate", &animate)) {
-        g_monitor.SetAnimateGraphs(animate);
-    }
-    
-    float fps = g_monitor.GetGraphFPS();
-    if (ImGui::SliderFloat("FPS", &fps, 1.0f, 60.0f)) {
-        g_monitor.SetGraphFPS(fps);
+void SystemManager::OpenHistory(const std::string& directory) {
+    std::vector<std::string> names;
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        names.push_back(MetricName(m));
     }
-    
-    float scale = g_monitor.GetGraphYScale();
-    if (ImGui::SliderFloat("Y Scale", &scale, 50.0f, 200.0f)) {
-        g_monitor.SetGraphYScale(scale);
-    }
-}
+    if (!history_store.Open(directory, names)) return;
 
-// SystemMonitor Implementation
-SystemMonitor::SystemMonitor() : memory_manager(&const_cast<SystemInfo&>(system_manager.GetSystemInfo())) {
-    system_manager.Initialize();
+    double since = WallSeconds() - TieredHistory::TIER_SECONDS[TieredHistory::TIER_10M] *
+                                   TieredHistory::TIER_CAPACITY[TieredHistory::TIER_10M];
+    history_store.Load(since, [this](int metric, const HistoryBucket& bucket) {
+        if (metric < METRIC_COUNT) MetricHistory(metric).Restore(bucket);
+    });
 }
 
-void SystemMonitor::Update() {
-    std::lock_guard<std::mutex> lock(data_mutex);
-    
-    system_manager.Update();
-    memory_manager.Update();
-    network_manager.Update();
-}
+void SystemManager::RecordSeries(const char* name, double time, float value) {
+    if (!history_store.IsOpen()) return;
 
-void SystemMonitor::RenderSystemMonitor() {
-    std::lock_guard<std::mutex> lock(data_mutex);
-    
-    if (ImGui::BeginTabBar("MainTabs")) {
-        if (ImGui::BeginTabItem("System Monitor")) {
-            system_manager.RenderSystemInfo();
-            ImGui::EndTabItem();
-        }
-        
-        if (ImGui::BeginTabItem("Memory & Processes")) {
-            memory_manager.RenderMemoryAndProcesses();
-            ImGui::EndTabItem();
-        }
-        
-        if (ImGui::BeginTabItem("Network")) {
-            network_manager.RenderNetwork();
-            ImGui::EndTabItem();
+    StoredSeries* series = nullptr;
+    for (StoredSeries& candidate : stored_series) {
+        if (candidate.name == name) {
+            series = &candidate;
+            break;
         }
-        
-        ImGui::EndTabBar();
     }
-}
\ No newline at end of file
+    if (!series) {
+        stored_series.emplace_back();
+        series = &stored_series.back();
+        series->name = name;
+        series->metric = history_store.AddMetric(name);
+    }
+
+    // Same 10 s alignment as TieredHistory, so every stored series lines up
+    double start = std::floor(time / TieredHistory::TIER_SECONDS[TieredHistory::TIER_10S]) *
+                   TieredHistory::TIER_SECONDS[TieredHistory::TIER_10S];
+    HistoryBucket& bucket = series->open;
+    if (bucket.count > 0 && bucket.time != start) {
+        history_store.Append(series->metric, bucket);
+        bucket = HistoryBucket();
+    }
+    if (bucket.count == 0) bucket.time = start;
+    bucket.Add(value);
+}
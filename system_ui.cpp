@@ -0,0 +1,429 @@
+#include "header.h"
+
+void SystemView::RenderSystemInfo(const MonitorSnapshot& snapshot) {
+    // Basic system information
+    ImGui::Text("Operating System: %s", snapshot.system_info.os_type.c_str());
+    ImGui::Text("User: %s", snapshot.system_info.username.c_str());
+    ImGui::Text("Hostname: %s", snapshot.system_info.hostname.c_str());
+    ImGui::Text("Total Processes: %d", snapshot.system_info.total_processes);
+    ImGui::Text("Running: %d, Sleeping: %d, Zombie: %d, Stopped: %d", 
+               snapshot.system_info.running_processes, snapshot.system_info.sleeping_processes,
+               snapshot.system_info.zombie_processes, snapshot.system_info.stopped_processes);
+    ImGui::Text("CPU: %s", snapshot.system_info.cpu_type.c_str());
+    
+    ImGui::Separator();
+    
+    // Performance tabs
+    if (ImGui::BeginTabBar("PerformanceTabs")) {
+        if (ImGui::BeginTabItem("CPU")) {
+            RenderCPUTab(snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Fan")) {
+            RenderFanTab(snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Thermal")) {
+            RenderThermalTab(snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        ImGui::EndTabBar();
+    }
+}
+
+static const ImVec4 CPU_SHARE_COLORS[CPUTimes::SHARE_COUNT] = {
+    ImVec4(0.30f, 0.69f, 0.31f, 1.0f),  // user
+    ImVec4(0.96f, 0.26f, 0.21f, 1.0f),  // system
+    ImVec4(1.00f, 0.76f, 0.03f, 1.0f),  // iowait
+    ImVec4(0.61f, 0.15f, 0.69f, 1.0f),  // irq
+    ImVec4(0.91f, 0.12f, 0.39f, 1.0f),  // softirq
+    ImVec4(0.13f, 0.59f, 0.95f, 1.0f),  // steal
+    ImVec4(0.25f, 0.25f, 0.25f, 1.0f),  // idle
+};
+
+static const char* HISTORY_TIER_NAMES[TieredHistory::TIER_COUNT] = {"raw", "10 s", "1 min", "10 min"};
+
+// The points of one tier inside the selected time window: completed buckets
+// and, for rollup tiers, the bucket still filling up. They are copied out of
+// the collector's ring first, so a ring that moved on past its slack while
+// the snapshot was held is detected before anything is drawn.
+struct HistoryWindow {
+    int tier = TieredHistory::TIER_RAW;
+    double begin = 0.0;
+    double seconds = 1.0;
+    double width = 0.0;         // Bucket width, 0 for raw samples
+    double max_gap = 0.0;       // Points further apart are not joined
+    const HistoryBucket* points = nullptr;
+    size_t count = 0;
+
+    const HistoryBucket& operator[](size_t i) const { return points[i]; }
+    // Middle of the bucket, where its point is drawn
+    double Time(size_t i) const { return (*this)[i].time + width * 0.5; }
+};
+
+// False when the ring was overwritten while copying; the plot is skipped for this frame
+static bool GetHistoryWindow(const TieredHistory::View& view, int tier, std::vector<HistoryBucket>& copy,
+                             HistoryWindow& window) {
+    window.tier = tier;
+    window.seconds = SystemMonitor::GraphWindowSeconds(g_monitor.GetGraphWindow());
+    window.begin = g_monitor.GetGraphEndTime() - window.seconds;
+    window.width = TieredHistory::TIER_SECONDS[tier];
+
+    // Times are ascending, so the first visible bucket is a binary search away
+    const RingSpans<HistoryBucket>& buckets = view.tiers[tier];
+    size_t low = 0, high = buckets.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (buckets[mid].time + window.width < window.begin) low = mid + 1;
+        else high = mid;
+    }
+    copy.clear();
+    for (size_t i = low; i < buckets.size(); ++i) {
+        copy.push_back(buckets[i]);
+    }
+    if (view.Overwritten(tier)) {
+        window.count = 0;
+        return false;
+    }
+    if (tier != TieredHistory::TIER_RAW && view.open[tier].count > 0) copy.push_back(view.open[tier]);
+    window.points = copy.data();
+    window.count = copy.size();
+
+    if (tier != TieredHistory::TIER_RAW) {
+        window.max_gap = window.width * 2.0;
+    } else if (window.count > 1) {
+        window.max_gap = std::max(1.0, 3.0 * (window.Time(window.count - 1) - window.Time(0)) / (window.count - 1));
+    }
+    return true;
+}
+
+// Average line placed by timestamp, so time the monitor was not running stays
+// a gap. Rollup tiers also shade each bucket's min..max range. A scale_max
+// at or below scale_min fits the scale to the visible maximum.
+static void PlotHistory(const char* label, const TieredHistory::View& history, float scale_min, float scale_max, ImVec2 size) {
+    ScopedLatency timer(g_monitor.GetRenderLatency(RENDER_GRAPHS));
+    if (size.x <= 0.0f) size.x = ImGui::CalcItemWidth();
+    double seconds = SystemMonitor::GraphWindowSeconds(g_monitor.GetGraphWindow());
+    static std::vector<HistoryBucket> points;   // UI thread only; capacity kept across frames
+    HistoryWindow window;
+    if (!GetHistoryWindow(history, history.PickTier(seconds, (size_t)size.x), points, window)) {
+        ImGui::Dummy(size);
+        return;
+    }
+    
+    if (scale_max <= scale_min) {
+        for (size_t i = 0; i < window.count; ++i) {
+            scale_max = std::max(scale_max, window[i].max);
+        }
+        scale_max = std::max(scale_max, scale_min + 1.0f);
+    }
+    
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y),
+                             ImGui::GetColorU32(ImGuiCol_FrameBg));
+    draw_list->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+    
+    auto to_x = [&](double time) { return origin.x + (float)((time - window.begin) / window.seconds) * size.x; };
+    auto to_y = [&](float value) {
+        float t = std::max(0.0f, std::min(1.0f, (value - scale_min) / (scale_max - scale_min)));
+        return origin.y + size.y * (1.0f - t);
+    };
+    
+    ImU32 line_color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    ImU32 band_color = ImGui::GetColorU32(ImGuiCol_PlotLines, 0.3f);
+    for (size_t i = 0; i < window.count; ++i) {
+        const HistoryBucket& bucket = window[i];
+        if (window.width > 0.0) {
+            draw_list->AddRectFilled(ImVec2(to_x(bucket.time), to_y(bucket.max)),
+                                     ImVec2(to_x(bucket.time + window.width), to_y(bucket.min)), band_color);
+        }
+        if (i > 0 && window.Time(i) - window.Time(i - 1) <= window.max_gap) {
+            draw_list->AddLine(ImVec2(to_x(window.Time(i - 1)), to_y(window[i - 1].Average())),
+                               ImVec2(to_x(window.Time(i)), to_y(bucket.Average())), line_color);
+        }
+    }
+    
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%s (%s)", label, HISTORY_TIER_NAMES[window.tier]);
+    draw_list->AddText(ImVec2(origin.x + 4.0f, origin.y + 2.0f), ImGui::GetColorU32(ImGuiCol_Text), overlay);
+    draw_list->PopClipRect();
+    
+    ImGui::Dummy(size);
+    if (ImGui::IsItemHovered() && window.count > 0) {
+        // Nearest point to the mouse
+        double time = window.begin + (ImGui::GetIO().MousePos.x - origin.x) / size.x * window.seconds;
+        size_t nearest = 0;
+        for (size_t i = 1; i < window.count; ++i) {
+            if (std::fabs(window.Time(i) - time) < std::fabs(window.Time(nearest) - time)) nearest = i;
+        }
+        const HistoryBucket& bucket = window[nearest];
+        ImGui::BeginTooltip();
+        ImGui::Text("%.0f s ago", g_monitor.GetGraphEndTime() - window.Time(nearest));
+        if (window.width > 0.0) {
+            ImGui::Text("avg %.1f  min %.1f  max %.1f  (%u samples)", bucket.Average(), bucket.min, bucket.max, bucket.count);
+        } else {
+            ImGui::Text("%.1f", bucket.Average());
+        }
+        ImGui::EndTooltip();
+    }
+}
+
+void SystemView::RenderCPUTab(const MonitorSnapshot& snapshot) {
+    ImGui::Text("CPU Usage: %.1f%%", snapshot.system_info.cpu_usage);
+    
+    // Full time breakdown of the whole machine
+    if (snapshot.cpu_times.slots > 0) {
+        for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+            if (s > 0) ImGui::SameLine();
+            ImGui::TextColored(CPU_SHARE_COLORS[s], "%s %.1f%%", CPUTimes::ShareName(s), snapshot.cpu_times.percent[s][0]);
+        }
+    }
+    
+    RenderGraphControls();
+    
+    if (!snapshot.cpu_history.empty()) {
+        // Pausing the animation freezes the window; recording carries on
+        PlotHistory("CPU Usage", snapshot.cpu_history, 0.0f, g_monitor.GetGraphYScale(), ImVec2(0, 200));
+        
+        // Overlay text
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 50);
+        ImGui::Text("Current: %.1f%%", snapshot.system_info.cpu_usage);
+    }
+    
+    ImGui::Separator();
+    ImGui::Text("Time breakdown:");
+    RenderCPUBreakdownGraph(snapshot);
+    
+    ImGui::Separator();
+    ImGui::Text("Per-core usage (%d cores):", snapshot.cpu_times.CoreCount());
+    RenderCoreGrid(snapshot);
+}
+
+// Stacked columns of every non-idle share's average over the time window.
+// All shares are recorded together, so their buckets line up index for index.
+void SystemView::RenderCPUBreakdownGraph(const MonitorSnapshot& snapshot) {
+    ScopedLatency timer(g_monitor.GetRenderLatency(RENDER_GRAPHS));
+    ImVec2 size(ImGui::GetContentRegionAvail().x, 120.0f);
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y),
+                             ImGui::GetColorU32(ImGuiCol_FrameBg));
+    draw_list->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+    
+    double seconds = SystemMonitor::GraphWindowSeconds(g_monitor.GetGraphWindow());
+    int tier = snapshot.cpu_share_history[0].PickTier(seconds, (size_t)size.x);
+    static std::vector<HistoryBucket> points[CPUTimes::SHARE_IDLE];
+    HistoryWindow windows[CPUTimes::SHARE_IDLE];
+    ImU32 colors[CPUTimes::SHARE_IDLE];
+    size_t count = (size_t)-1;
+    for (int s = 0; s < CPUTimes::SHARE_IDLE; ++s) {
+        // An overwritten share leaves count at 0 and the graph empty for this frame
+        GetHistoryWindow(snapshot.cpu_share_history[s], tier, points[s], windows[s]);
+        colors[s] = ImGui::GetColorU32(CPU_SHARE_COLORS[s]);
+        count = std::min(count, windows[s].count);
+    }
+    
+    const HistoryWindow& window = windows[0];
+    auto to_x = [&](double time) { return origin.x + (float)((time - window.begin) / window.seconds) * size.x; };
+    for (size_t i = 0; i < count; ++i) {
+        // A column reaches the next point unless there is a gap in the history
+        double start = window[i].time;
+        double end = start + window.width;
+        if (window.width == 0.0) {
+            double next = i + 1 < count ? window[i + 1].time : start;
+            end = (next > start && next - start <= window.max_gap) ? next : start + window.max_gap / 3.0;
+        }
+        float x0 = to_x(start);
+        float x1 = std::max(to_x(end), x0 + 1.0f);
+        float bottom = origin.y + size.y;
+        for (int s = 0; s < CPUTimes::SHARE_IDLE; ++s) {
+            float height = windows[s][i].Average() / 100.0f * size.y;
+            if (height <= 0.0f) continue;
+            draw_list->AddRectFilled(ImVec2(x0, bottom - height), ImVec2(x1, bottom), colors[s]);
+            bottom -= height;
+        }
+    }
+    
+    draw_list->PopClipRect();
+    ImGui::Dummy(size);
+}
+
+// Grid of per-core busy bars, in the steal color when steal is above 5%
+void SystemView::RenderCoreGrid(const MonitorSnapshot& snapshot) {
+    int cores = snapshot.cpu_times.CoreCount();
+    if (cores == 0) return;
+    
+    int columns = std::max(1, std::min(8, (int)(ImGui::GetContentRegionAvail().x / 110.0f)));
+    if (ImGui::BeginTable("CoreGrid", columns, ImGuiTableFlags_ColumnsWidthStretch)) {
+        char label[48];
+        for (int core = 0; core < cores; ++core) {
+            size_t slot = core + 1;
+            ImGui::TableNextColumn();
+            
+            float busy = snapshot.cpu_times.busy[slot];
+            float steal = snapshot.cpu_times.percent[CPUTimes::SHARE_STEAL][slot];
+            snprintf(label, sizeof(label), "cpu%d %.0f%%", snapshot.cpu_times.CoreId(core), busy);
+            
+            // Steal shows up as its own color so noisy neighbours stand out
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, steal > 5.0f ? CPU_SHARE_COLORS[CPUTimes::SHARE_STEAL]
+                                                                        : CPU_SHARE_COLORS[CPUTimes::SHARE_USER]);
+            ImGui::ProgressBar(busy / 100.0f, ImVec2(-1, 0), label);
+            ImGui::PopStyleColor();
+            
+            if (ImGui::IsItemHovered()) {
+                ImGui::BeginTooltip();
+                for (int s = 0; s < CPUTimes::SHARE_COUNT; ++s) {
+                    ImGui::TextColored(CPU_SHARE_COLORS[s], "%-8s %5.1f%%", CPUTimes::ShareName(s), snapshot.cpu_times.percent[s][slot]);
+                }
+                ImGui::EndTooltip();
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void SystemView::RenderFanTab(const MonitorSnapshot& snapshot) {
+    ImGui::Text("Fan Status: %s", snapshot.system_info.fan_active ? "Active" : "Inactive");
+    ImGui::Text("Fan Speed: %d RPM", snapshot.system_info.fan_speed);
+    
+    RenderGraphControls();
+    
+    if (!snapshot.fan_history.empty()) {
+        PlotHistory("Fan Speed", snapshot.fan_history, 0.0f, 0.0f, ImVec2(0, 200));
+    }
+}
+
+void SystemView::RenderThermalTab(const MonitorSnapshot& snapshot) {
+    ImGui::Text("Temperature: %.1f°C", snapshot.system_info.temperature);
+    
+    RenderGraphControls();
+    
+    if (!snapshot.temp_history.empty()) {
+        PlotHistory("Temperature", snapshot.temp_history, 0.0f, 100.0f, ImVec2(0, 200));
+        
+        // Overlay text
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 50);
+        ImGui::Text("Current: %.1f°C", snapshot.system_info.temperature);
+    }
+}
+
+void SystemView::RenderGraphControls() {
+    bool animate = g_monitor.GetAnimateGraphs();
+    if (ImGui::Checkbox("Animate", &animate)) {
+        g_monitor.SetAnimateGraphs(animate);
+    }
+    
+    float fps = g_monitor.GetGraphFPS();
+    if (ImGui::SliderFloat("FPS", &fps, 1.0f, 60.0f)) {
+        g_monitor.SetGraphFPS(fps);
+    }
+    
+    float scale = g_monitor.GetGraphYScale();
+    if (ImGui::SliderFloat("Y Scale", &scale, 50.0f, 200.0f)) {
+        g_monitor.SetGraphYScale(scale);
+    }
+    
+    int window = g_monitor.GetGraphWindow();
+    if (ImGui::BeginCombo("Time window", SystemMonitor::GraphWindowName(window))) {
+        for (int w = 0; w < SystemMonitor::GRAPH_WINDOW_COUNT; ++w) {
+            if (ImGui::Selectable(SystemMonitor::GraphWindowName(w), w == window)) {
+                g_monitor.SetGraphWindow(w);
+            }
+        }
+        ImGui::EndCombo();
+    }
+}
+
+// SystemMonitor Implementation
+SystemMonitor::SystemMonitor() : memory_view(collector.GetMemoryManager()) {}
+
+const char* SystemMonitor::GraphWindowName(int window) {
+    static const char* names[GRAPH_WINDOW_COUNT] = {"1 min", "10 min", "1 hour", "6 hours", "1 day", "1 week"};
+    return window >= 0 && window < GRAPH_WINDOW_COUNT ? names[window] : "?";
+}
+
+double SystemMonitor::GraphWindowSeconds(int window) {
+    static const double seconds[GRAPH_WINDOW_COUNT] = {60.0, 600.0, 3600.0, 21600.0, 86400.0, 604800.0};
+    return window >= 0 && window < GRAPH_WINDOW_COUNT ? seconds[window] : 60.0;
+}
+
+const char* SystemMonitor::RenderPhaseName(int phase) {
+    static const char* names[RENDER_PHASE_COUNT] = {"frame", "system tab", "graphs", "process table", "network tab"};
+    return phase >= 0 && phase < RENDER_PHASE_COUNT ? names[phase] : "?";
+}
+
+void SystemMonitor::RenderSystemMonitor() {
+    const MonitorSnapshot* snapshot = collector.AcquireSnapshot();
+    if (!snapshot) return;
+    ScopedLatency frame_timer(render_latency[RENDER_FRAME]);
+    
+    if (animate_graphs) {
+        graph_end_time = WallSeconds();
+    }
+    
+    if (ImGui::BeginTabBar("MainTabs")) {
+        if (ImGui::BeginTabItem("System Monitor")) {
+            ScopedLatency timer(render_latency[RENDER_SYSTEM_TAB]);
+            system_view.RenderSystemInfo(*snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Memory & Processes")) {
+            memory_view.RenderMemoryAndProcesses(*snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Network")) {
+            ScopedLatency timer(render_latency[RENDER_NETWORK_TAB]);
+            network_view.RenderNetwork(*snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Monitor Overhead")) {
+            overhead_view.RenderOverhead(*snapshot);
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Settings")) {
+            RenderSettings();
+            ImGui::EndTabItem();
+        }
+        
+        ImGui::EndTabBar();
+    }
+    
+    collector.ReleaseSnapshot(snapshot);
+}
+
+void SystemMonitor::RenderSettings() {
+    ImGui::Text("Sampling intervals");
+    ImGui::TextDisabled("Each collector runs on its own schedule; changes are saved to %s",
+                        Config::DefaultPath().c_str());
+    ImGui::Separator();
+    
+    for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+        int interval = collector.GetScheduler().GetInterval(c);
+        ImGui::SetNextItemWidth(300);
+        if (ImGui::SliderInt(CollectorScheduler::Name(c), &interval, CollectorScheduler::MIN_INTERVAL_MS,
+                             10000, "%d ms", ImGuiSliderFlags_Logarithmic)) {
+            collector.GetScheduler().SetInterval(c, interval);
+        }
+        // Reschedule and save once the slider is released, not on every drag step
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            collector.GetScheduler().Commit();
+            collector.Wake();
+        }
+    }
+    
+    if (ImGui::Button("Restore defaults")) {
+        for (int c = 0; c < COLLECTOR_COUNT; ++c) {
+            collector.GetScheduler().SetInterval(c, CollectorScheduler::DefaultInterval(c));
+        }
+        collector.GetScheduler().Commit();
+        collector.Wake();
+    }
+}
@@ -0,0 +1,76 @@
+#include "collector.h"
+
+// WorkerPool Implementation
+WorkerPool::~WorkerPool() {
+    Resize(0);
+}
+
+void WorkerPool::Resize(int thread_count) {
+    if (thread_count < 0) thread_count = 0;
+    if (thread_count == (int)threads.size()) return;
+
+    // Stop every worker and start the new set; resizing is rare
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    stopping = false;
+    for (int i = 0; i < thread_count; ++i) {
+        threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+void WorkerPool::RunShards(std::unique_lock<std::mutex>& lock) {
+    while (next_shard < job_shards) {
+        int shard = next_shard++;
+        const std::function<void(int)>* fn = job;
+
+        lock.unlock();
+        (*fn)(shard);
+        lock.lock();
+
+        if (--pending_shards == 0) {
+            done_cv.notify_all();
+        }
+    }
+}
+
+void WorkerPool::WorkerLoop() {
+    uint64_t seen_job = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    seen_job = job_id;
+    while (true) {
+        work_cv.wait(lock, [&] { return stopping || job_id != seen_job; });
+        if (stopping) return;
+
+        seen_job = job_id;
+        RunShards(lock);
+    }
+}
+
+void WorkerPool::Run(int shards, const std::function<void(int)>& fn) {
+    if (shards <= 0) return;
+    if (threads.empty() || shards == 1) {
+        for (int i = 0; i < shards; ++i) fn(i);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &fn;
+    job_shards = shards;
+    next_shard = 0;
+    pending_shards = shards;
+    job_id++;
+    work_cv.notify_all();
+
+    // The calling thread takes shards too
+    RunShards(lock);
+    done_cv.wait(lock, [&] { return pending_shards == 0; });
+    job = nullptr;
+}